@@ -0,0 +1,234 @@
+#include "strong_typedef.hpp"
+#include "strong_typedef_bulk.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Runtime benchmarks comparing hot loops over strong_typedef values with the
+// same loops over the raw underlying values. Each benchmark is run several
+// times and the fastest run is reported, along with the ratio of the
+// strong_typedef time to the raw time. A ratio close to 1.0 means there is no
+// abstraction penalty.
+
+namespace {
+    namespace props= jss::strong_typedef_properties;
+
+    using int_value= jss::strong_typedef<
+        struct int_value_tag, int, props::addable, props::subtractable,
+        props::multiplicable, props::comparable>;
+    using double_value= jss::strong_typedef<
+        struct double_value_tag, double, props::addable,
+        props::multiplicable, props::ordered>;
+    using string_key= jss::strong_typedef<
+        struct string_key_tag, std::string, props::equality_comparable,
+        props::hashable>;
+    using int_key= jss::strong_typedef<
+        struct int_key_tag, int, props::equality_comparable, props::hashable>;
+
+    constexpr std::size_t element_count= 1 << 16;
+    constexpr unsigned repetitions= 25;
+
+    /// Prevent the optimizer from discarding a computed value. With GCC
+    /// and Clang, an empty asm statement that takes the address of the
+    /// value and clobbers memory makes the compiler assume that the value
+    /// is read; elsewhere the address is written to and read back from a
+    /// volatile variable.
+    template <typename T> void keep(T const &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        void const *volatile sink= &value;
+        static_cast<void>(sink);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /// Time the supplied function, returning the fastest run in nanoseconds
+    /// per element
+    template <typename Func> double time_per_element(Func func) {
+        double best= 0;
+        for(unsigned i= 0; i < repetitions; ++i) {
+            auto const start= std::chrono::steady_clock::now();
+            func();
+            auto const end= std::chrono::steady_clock::now();
+            double const elapsed=
+                std::chrono::duration<double, std::nano>(end - start).count() /
+                element_count;
+            if(i == 0 || elapsed < best)
+                best= elapsed;
+        }
+        return best;
+    }
+
+    void report(char const *name, double raw, double strong) {
+        std::cout << std::left << std::setw(28) << name << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(14)
+                  << raw << std::setw(14) << strong << std::setw(10)
+                  << (raw > 0 ? strong / raw : 0.0) << std::endl;
+    }
+
+    template <typename T> std::vector<T> make_ints() {
+        std::vector<T> result;
+        result.reserve(element_count);
+        unsigned seed= 12345;
+        for(std::size_t i= 0; i < element_count; ++i) {
+            seed= seed * 1103515245u + 12345u;
+            result.push_back(T(static_cast<int>(seed >> 8) & 0xffff));
+        }
+        return result;
+    }
+
+    template <typename T> std::vector<T> make_doubles() {
+        std::vector<T> result;
+        result.reserve(element_count);
+        for(std::size_t i= 0; i < element_count; ++i) {
+            result.push_back(T(1.0 + static_cast<double>(i % 1000) / 1000.0));
+        }
+        return result;
+    }
+
+    template <typename T> std::vector<T> make_strings() {
+        std::vector<T> result;
+        result.reserve(element_count);
+        for(std::size_t i= 0; i < element_count; ++i) {
+            result.push_back(T("key-" + std::to_string(i * 7919)));
+        }
+        return result;
+    }
+
+    template <typename T> void sum_loop(std::vector<T> const &values) {
+        T total(0);
+        for(auto const &v : values)
+            total+= v;
+        keep(total);
+    }
+
+    template <typename T>
+    void multiply_add_loop(
+        std::vector<T> const &lhs, std::vector<T> const &rhs,
+        std::vector<T> &out) {
+        for(std::size_t i= 0; i < lhs.size(); ++i)
+            out[i]= lhs[i] * rhs[i] + lhs[i];
+        keep(out[0]);
+    }
+
+    template <typename T> void compare_loop(std::vector<T> const &values) {
+        std::size_t count= 0;
+        T const pivot= values[values.size() / 2];
+        for(auto const &v : values)
+            count+= (v < pivot) + (v >= pivot);
+        keep(count);
+    }
+
+    template <typename T> void sort_loop(std::vector<T> const &values) {
+        std::vector<T> copy(values);
+        std::sort(copy.begin(), copy.end());
+        keep(copy[0]);
+    }
+
+    template <typename T>
+    void hash_lookup_loop(
+        std::unordered_set<T> const &set, std::vector<T> const &values) {
+        std::size_t found= 0;
+        for(auto const &v : values)
+            found+= set.count(v);
+        keep(found);
+    }
+
+    void bench_addable() {
+        auto const raw= make_ints<int>();
+        auto const strong= make_ints<int_value>();
+        report(
+            "addable<int> sum", time_per_element([&] { sum_loop(raw); }),
+            time_per_element([&] { sum_loop(strong); }));
+    }
+
+    void bench_multiplicable() {
+        auto const raw= make_doubles<double>();
+        auto const strong= make_doubles<double_value>();
+        std::vector<double> raw_out(raw.size());
+        std::vector<double_value> strong_out(strong.size());
+        report(
+            "multiplicable<double> fma",
+            time_per_element([&] { multiply_add_loop(raw, raw, raw_out); }),
+            time_per_element(
+                [&] { multiply_add_loop(strong, strong, strong_out); }));
+    }
+
+    void bench_bulk() {
+        auto const raw= make_doubles<double>();
+        auto const strong= make_doubles<double_value>();
+        std::vector<double> raw_out(raw.size());
+        std::vector<double_value> strong_out(strong.size());
+        report(
+            "bulk fused_multiply_add",
+            time_per_element([&] { multiply_add_loop(raw, raw, raw_out); }),
+            time_per_element([&] {
+                jss::bulk::fused_multiply_add(
+                    strong, strong, strong, strong_out);
+                keep(strong_out[0]);
+            }));
+        report(
+            "bulk reduce",
+            time_per_element([&] { keep(jss::bulk::reduce(raw)); }),
+            time_per_element([&] { keep(jss::bulk::reduce(strong)); }));
+    }
+
+    void bench_ordered() {
+        auto const raw= make_ints<int>();
+        auto const strong= make_ints<int_value>();
+        report(
+            "ordered<int> compare",
+            time_per_element([&] { compare_loop(raw); }),
+            time_per_element([&] { compare_loop(strong); }));
+        report(
+            "ordered<int> sort", time_per_element([&] { sort_loop(raw); }),
+            time_per_element([&] { sort_loop(strong); }));
+    }
+
+    void bench_hashable() {
+        auto const raw_ints= make_ints<int>();
+        auto const strong_ints= make_ints<int_key>();
+        std::unordered_set<int> const raw_int_set(
+            raw_ints.begin(), raw_ints.end());
+        std::unordered_set<int_key> const strong_int_set(
+            strong_ints.begin(), strong_ints.end());
+        report(
+            "hashable<int> lookup",
+            time_per_element(
+                [&] { hash_lookup_loop(raw_int_set, raw_ints); }),
+            time_per_element(
+                [&] { hash_lookup_loop(strong_int_set, strong_ints); }));
+
+        auto const raw_strings= make_strings<std::string>();
+        auto const strong_strings= make_strings<string_key>();
+        std::unordered_set<std::string> const raw_string_set(
+            raw_strings.begin(), raw_strings.end());
+        std::unordered_set<string_key> const strong_string_set(
+            strong_strings.begin(), strong_strings.end());
+        report(
+            "hashable<string> lookup",
+            time_per_element(
+                [&] { hash_lookup_loop(raw_string_set, raw_strings); }),
+            time_per_element([&] {
+                hash_lookup_loop(strong_string_set, strong_strings);
+            }));
+    }
+} // namespace
+
+int main() {
+    std::cout << std::left << std::setw(28) << "benchmark" << std::right
+              << std::setw(14) << "raw ns/op" << std::setw(14)
+              << "strong ns/op" << std::setw(10) << "ratio" << std::endl;
+    bench_addable();
+    bench_multiplicable();
+    bench_bulk();
+    bench_ordered();
+    bench_hashable();
+}
@@ -0,0 +1,112 @@
+#include "strong_typedef.hpp"
+#include <cstddef>
+#include <functional>
+
+// Code generation comparison for strong_typedef. This file is compiled twice:
+// once with JSS_CODEGEN_RAW defined, where each value type is the plain
+// underlying type, and once without, where each value type is a
+// strong_typedef with the relevant properties. The functions have C linkage
+// so the symbol names are identical in both builds, and the generated
+// assembly and object sizes can be compared directly. JSS_CODEGEN_CASE
+// selects the property combination to compile.
+
+namespace props= jss::strong_typedef_properties;
+
+#ifdef JSS_CODEGEN_RAW
+#define JSS_CODEGEN_TYPE(tag, value_type, ...) value_type
+#else
+#define JSS_CODEGEN_TYPE(tag, value_type, ...)                                 \
+    jss::strong_typedef<struct tag, value_type, __VA_ARGS__>
+#endif
+
+#ifndef JSS_CODEGEN_CASE
+#define JSS_CODEGEN_CASE 0
+#endif
+
+#if JSS_CODEGEN_CASE == 0 || JSS_CODEGEN_CASE == 1
+using int_addable= JSS_CODEGEN_TYPE(int_addable_tag, int, props::addable);
+
+extern "C" int codegen_addable_sum(int_addable const *values, std::size_t n) {
+    int_addable total(0);
+    for(std::size_t i= 0; i < n; ++i)
+        total+= values[i];
+    return static_cast<int>(total);
+}
+
+extern "C" void codegen_addable_add(
+    int_addable const *lhs, int_addable const *rhs, int_addable *out,
+    std::size_t n) {
+    for(std::size_t i= 0; i < n; ++i)
+        out[i]= lhs[i] + rhs[i];
+}
+#endif
+
+#if JSS_CODEGEN_CASE == 0 || JSS_CODEGEN_CASE == 2
+using double_arithmetic= JSS_CODEGEN_TYPE(
+    double_arithmetic_tag, double, props::addable, props::subtractable,
+    props::multiplicable, props::divisible);
+
+extern "C" void codegen_arithmetic_axpy(
+    double_arithmetic const *x, double_arithmetic *y, double a,
+    std::size_t n) {
+    for(std::size_t i= 0; i < n; ++i)
+        y[i]= x[i] * a + y[i];
+}
+
+extern "C" double
+codegen_arithmetic_mixed(double_arithmetic lhs, double_arithmetic rhs) {
+    return static_cast<double>((lhs - rhs) / (lhs + rhs) * lhs);
+}
+#endif
+
+#if JSS_CODEGEN_CASE == 0 || JSS_CODEGEN_CASE == 3
+using int_comparable=
+    JSS_CODEGEN_TYPE(int_comparable_tag, int, props::comparable);
+
+extern "C" std::size_t codegen_comparable_count_less(
+    int_comparable const *values, std::size_t n, int_comparable pivot) {
+    std::size_t count= 0;
+    for(std::size_t i= 0; i < n; ++i)
+        count+= values[i] < pivot;
+    return count;
+}
+
+extern "C" bool
+codegen_comparable_in_range(int_comparable v, int_comparable lo,
+                            int_comparable hi) {
+    return lo <= v && v < hi && !(v == hi);
+}
+#endif
+
+#if JSS_CODEGEN_CASE == 0 || JSS_CODEGEN_CASE == 4
+using unsigned_counter= JSS_CODEGEN_TYPE(
+    unsigned_counter_tag, unsigned, props::incrementable,
+    props::decrementable, props::equality_comparable);
+
+extern "C" unsigned
+codegen_counter_count_to(unsigned_counter start, unsigned_counter end) {
+    unsigned steps= 0;
+    for(unsigned_counter c= start; !(c == end); ++c)
+        ++steps;
+    return steps;
+}
+#endif
+
+#if JSS_CODEGEN_CASE == 0 || JSS_CODEGEN_CASE == 5
+using unsigned_bits= JSS_CODEGEN_TYPE(
+    unsigned_bits_tag, unsigned, props::bitwise_or, props::bitwise_and,
+    props::bitwise_xor, props::bitwise_not,
+    props::bitwise_left_shift<unsigned>);
+
+extern "C" unsigned codegen_bitwise_mix(unsigned_bits a, unsigned_bits b) {
+    return static_cast<unsigned>(((a | b) & ~(a ^ b)) << 3u);
+}
+#endif
+
+#if JSS_CODEGEN_CASE == 0 || JSS_CODEGEN_CASE == 6
+using long_hashable= JSS_CODEGEN_TYPE(long_hashable_tag, long, props::hashable);
+
+extern "C" std::size_t codegen_hashable_hash(long_hashable value) {
+    return std::hash<long_hashable>()(value);
+}
+#endif
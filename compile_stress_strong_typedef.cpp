@@ -0,0 +1,158 @@
+#include "strong_typedef.hpp"
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+// Compile-time stress test for strong_typedef. This creates
+// JSS_STRESS_TYPEDEFS distinct strong_typedef instantiations, each with the
+// first JSS_STRESS_PROPERTIES properties from the list below, and uses every
+// operation those properties provide so that all the mixin friends are
+// instantiated. The make target compile-stress compiles this file for a
+// range of values and reports the compiler's own time and memory usage.
+
+#ifndef JSS_STRESS_TYPEDEFS
+#define JSS_STRESS_TYPEDEFS 100
+#endif
+
+#ifndef JSS_STRESS_PROPERTIES
+#define JSS_STRESS_PROPERTIES 20
+#endif
+
+namespace props= jss::strong_typedef_properties;
+
+namespace {
+    template <std::size_t I> struct stress_tag;
+
+    using property_list= std::tuple<
+        props::equality_comparable, props::ordered, props::pre_incrementable,
+        props::post_incrementable, props::pre_decrementable,
+        props::post_decrementable, props::addable, props::subtractable,
+        props::multiplicable, props::divisible, props::modulus,
+        props::bitwise_or, props::bitwise_and, props::bitwise_xor,
+        props::bitwise_not, props::bitwise_left_shift<int>,
+        props::bitwise_right_shift<int>, props::mixed_ordered<long>,
+        props::hashable, props::streamable>;
+
+    constexpr std::size_t property_count= JSS_STRESS_PROPERTIES;
+
+    static_assert(
+        property_count <= std::tuple_size<property_list>::value,
+        "Too many properties requested");
+
+    template <std::size_t I, typename Indexes> struct make_typedef;
+
+    template <std::size_t I, std::size_t... P>
+    struct make_typedef<I, std::index_sequence<P...>> {
+        using type= jss::strong_typedef<
+            stress_tag<I>, int, std::tuple_element_t<P, property_list>...>;
+    };
+
+    template <std::size_t I>
+    using stress_typedef= typename make_typedef<
+        I, std::make_index_sequence<property_count>>::type;
+
+    int sink;
+
+    template <typename T> void use(T const &value) {
+        using jss::underlying_value;
+        sink+= static_cast<int>(underlying_value(value));
+    }
+
+    template <std::size_t I> void exercise() {
+        using T= stress_typedef<I>;
+        T a(static_cast<int>(I) + 1);
+        T b(2);
+        constexpr std::size_t M= property_count;
+        if constexpr(M > 0)
+            use(a == b || a != b);
+        if constexpr(M > 1)
+            use(a < b || a > b || a <= b || a >= b);
+        if constexpr(M > 2)
+            use(++a);
+        if constexpr(M > 3)
+            use(a++);
+        if constexpr(M > 4)
+            use(--a);
+        if constexpr(M > 5)
+            use(a--);
+        if constexpr(M > 6) {
+            use(a + b);
+            use(a + 1);
+            use(1 + a);
+            use(a+= b);
+        }
+        if constexpr(M > 7) {
+            use(a - b);
+            use(a - 1);
+            use(a-= 1);
+        }
+        if constexpr(M > 8) {
+            use(a * b);
+            use(a * 1);
+            use(a*= b);
+        }
+        if constexpr(M > 9) {
+            use(a / b);
+            use(a / 1);
+            use(a/= 1);
+        }
+        if constexpr(M > 10) {
+            use(a % b);
+            use(a % 3);
+            use(a%= 5);
+        }
+        if constexpr(M > 11) {
+            use(a | b);
+            use(a|= 1);
+        }
+        if constexpr(M > 12) {
+            use(a & b);
+            use(a&= 3);
+        }
+        if constexpr(M > 13) {
+            use(a ^ b);
+            use(a^= 7);
+        }
+        if constexpr(M > 14)
+            use(~a);
+        if constexpr(M > 15) {
+            use(a << 1);
+            use(a<<= 1);
+        }
+        if constexpr(M > 16) {
+            use(a >> 1);
+            use(a>>= 1);
+        }
+        if constexpr(M > 17)
+            use(a < 3L || 3L < a || a >= 3L || 3L <= a);
+        if constexpr(M > 18)
+            use(std::hash<T>()(a));
+        if constexpr(M > 19) {
+            std::ostream *os= nullptr;
+            if(os)
+                *os << a;
+        }
+    }
+
+    /// Exercise the typedefs with indexes from Begin to End. The range is
+    /// split in half recursively, rather than expanding a single pack of all
+    /// the indexes, because the compiler's cost of expanding a pack grows
+    /// with its length for each element, which would make this harness
+    /// quadratic in the number of typedefs on its own.
+    template <std::size_t Begin, std::size_t End> void exercise_range() {
+        if constexpr(End - Begin == 1) {
+            exercise<Begin>();
+        } else if constexpr(End > Begin) {
+            constexpr std::size_t middle= Begin + (End - Begin) / 2;
+            exercise_range<Begin, middle>();
+            exercise_range<middle, End>();
+        }
+    }
+} // namespace
+
+int main() {
+    exercise_range<0, JSS_STRESS_TYPEDEFS>();
+    return sink == 42;
+}
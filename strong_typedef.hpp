@@ -1,10 +1,27 @@
 #ifndef JSS_STRONG_TYPEDEF_HPP
 #define JSS_STRONG_TYPEDEF_HPP
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 #include <functional>
 #include <ostream>
 
+#if __cplusplus > 201703L && defined(__has_include)
+#if __has_include(<compare>)
+#include <compare>
+#endif
+#endif
+
+/// MSVC only applies the empty base optimization to the first empty base
+/// class unless told otherwise, so a strong_typedef with several properties
+/// would be larger than its underlying value
+#ifdef _MSC_VER
+#define JSS_EMPTY_BASES __declspec(empty_bases)
+#else
+#define JSS_EMPTY_BASES
+#endif
+
 namespace jss {
     /// Internal implementation namespace
     namespace detail {
@@ -18,6 +35,123 @@ namespace jss {
 
     } // namespace detail
 
+    namespace strong_typedef_properties {
+        struct trivially_default_constructible;
+        struct hashable;
+        template <typename HashPolicy> struct hashable_with;
+    } // namespace strong_typedef_properties
+
+    namespace detail {
+        /// Check whether Property is one of Properties
+        template <typename Property, typename... Properties>
+        using has_property=
+            std::disjunction<std::is_same<Property, Properties>...>;
+
+        /// Check a value stored by the value constructor of a
+        /// strong_typedef. A property can restrict the values of a
+        /// strong_typedef by defining a static member function
+        /// validate_value, which is called with the value and throws if it
+        /// is not valid. Properties without validate_value accept any value.
+        template <typename Property, typename ValueType, typename= void>
+        struct property_validator {
+            static constexpr bool validates= false;
+            static constexpr bool is_nothrow= true;
+
+            static constexpr void validate(ValueType const &) noexcept {}
+        };
+
+        template <typename Property, typename ValueType>
+        struct property_validator<
+            Property, ValueType,
+            std::void_t<decltype(Property::validate_value(
+                std::declval<ValueType const &>()))>> {
+            static constexpr bool validates= true;
+            static constexpr bool is_nothrow= noexcept(
+                Property::validate_value(std::declval<ValueType const &>()));
+
+            static constexpr void
+            validate(ValueType const &value) noexcept(is_nothrow) {
+                Property::validate_value(value);
+            }
+        };
+
+        /// Check a value with the validators of all of Properties
+        template <typename ValueType, typename... Properties>
+        struct value_validator {
+            /// Whether any of Properties restricts the value
+            static constexpr bool validates=
+                std::disjunction<std::bool_constant<property_validator<
+                    Properties, ValueType>::validates>...>::value;
+            static constexpr bool is_nothrow=
+                std::conjunction<std::bool_constant<property_validator<
+                    Properties, ValueType>::is_nothrow>...>::value;
+
+            static constexpr void
+            validate(ValueType const &value) noexcept(is_nothrow) {
+                (property_validator<Properties, ValueType>::validate(value),
+                 ...);
+            }
+        };
+
+        /// Storage for the value of a strong_typedef. A default-constructed
+        /// strong_typedef normally has a value-initialized value, so the
+        /// default constructor is user-provided, and checks the value with
+        /// Validator. With the trivially_default_constructible property the
+        /// default constructor is defaulted instead, so it is trivial if the
+        /// default constructor of the value is trivial.
+        template <
+            typename ValueType, bool TriviallyDefaultConstructible,
+            typename Validator>
+        struct strong_typedef_storage {
+            constexpr strong_typedef_storage() noexcept(Validator::is_nothrow) :
+                value() {
+                Validator::validate(value);
+            }
+
+            explicit constexpr strong_typedef_storage(ValueType value_) noexcept(
+                std::is_nothrow_move_constructible<ValueType>::value) :
+                value(std::move(value_)) {}
+
+            ValueType value;
+        };
+
+        template <typename ValueType, typename Validator>
+        struct strong_typedef_storage<ValueType, true, Validator> {
+            strong_typedef_storage()= default;
+
+            explicit constexpr strong_typedef_storage(ValueType value_) noexcept(
+                std::is_nothrow_move_constructible<ValueType>::value) :
+                value(std::move(value_)) {}
+
+            ValueType value;
+        };
+
+        /// The number of bits needed to represent value, which must not be
+        /// zero
+        constexpr unsigned bit_width(std::uint32_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return 32 - static_cast<unsigned>(__builtin_clz(value));
+#else
+            unsigned width= 0;
+            for(; value; value>>= 1)
+                ++width;
+            return width;
+#endif
+        }
+
+        /// The non-owning view type for values of type T, if there is one.
+        /// strong_typedef_view.hpp specializes this for strings and vectors.
+        template <typename T> struct view_type {};
+
+        /// Check if View is the view type for values of type T
+        template <typename View, typename T, typename= void>
+        struct is_view_type : std::false_type {};
+
+        template <typename View, typename T>
+        struct is_view_type<View, T, std::void_t<typename view_type<T>::type>>
+            : std::is_same<View, typename view_type<T>::type> {};
+    } // namespace detail
+
     /// The strong_typedef template used to create unique types with
     /// specific properties.
     ///
@@ -31,61 +165,104 @@ namespace jss {
     /// Properties are types that provide mixins that enable certain operations
     /// on values of this type.
     template <typename Tag, typename ValueType, typename... Properties>
-    class strong_typedef
-        : public Properties::template mixin<
+    class JSS_EMPTY_BASES strong_typedef
+        : private detail::strong_typedef_storage<
+              ValueType,
+              detail::has_property<
+                  strong_typedef_properties::trivially_default_constructible,
+                  Properties...>::value,
+              detail::value_validator<ValueType, Properties...>>,
+          public Properties::template mixin<
               strong_typedef<Tag, ValueType, Properties...>, ValueType>... {
+        /// The checks on the value made by the properties
+        using validator= detail::value_validator<ValueType, Properties...>;
+        /// Whether the default constructor is trivial
+        static constexpr bool trivial_default= detail::has_property<
+            strong_typedef_properties::trivially_default_constructible,
+            Properties...>::value;
+        /// The base class that holds the underlying value
+        using storage= detail::
+            strong_typedef_storage<ValueType, trivial_default, validator>;
+
+        static_assert(
+            !(trivial_default && validator::validates),
+            "A strong_typedef with a property that restricts its values "
+            "cannot be trivially default constructible");
+
     public:
         /// The underlying value type
         using underlying_value_type= ValueType;
 
-        /// A default constructed strong_typedef has a default-constructed value
-        constexpr strong_typedef() noexcept : value() {}
+        /// A default constructed strong_typedef has a value-initialized
+        /// value, unless it has the trivially_default_constructible
+        /// property, in which case the value is default-initialized. The
+        /// value-initialized value is checked by any properties that
+        /// restrict the value, just as for the value constructor.
+        strong_typedef()= default;
 
-        /// Construct a strong_typedef holding the specified value
+        /// Construct a strong_typedef holding the specified value. The value
+        /// is checked by any properties that restrict it, such as bounded.
         explicit constexpr strong_typedef(ValueType value_) noexcept(
-            std::is_nothrow_move_constructible<ValueType>::value) :
-            value(std::move(value_)) {}
+            std::is_nothrow_move_constructible<ValueType>::value &&
+            validator::is_nothrow) :
+            storage(std::move(value_)) {
+            validator::validate(storage::value);
+        }
+
+        /// Construct a view of the value of a strong_typedef with the same
+        /// tag and properties, whose value type has ValueType as its view
+        /// type, such as a jss::view_of<Name> from a Name. The source must
+        /// outlive the view. As with the value constructor, the view is
+        /// checked by any properties that restrict its value.
+        template <
+            typename SourceValueType,
+            typename= std::enable_if_t<
+                detail::is_view_type<ValueType, SourceValueType>::value>>
+        constexpr strong_typedef(
+            strong_typedef<Tag, SourceValueType, Properties...> const
+                &source) noexcept(validator::is_nothrow) :
+            storage(ValueType(source.underlying_value())) {
+            validator::validate(storage::value);
+        }
 
         /// Explicit conversion operator to read the underlying value
         explicit constexpr operator ValueType const &() const noexcept {
-            return value;
+            return storage::value;
         }
 
         /// Get a const reference to the underlying value
         constexpr ValueType const &underlying_value() const noexcept {
-            return value;
+            return storage::value;
         }
 
         /// Get a reference to the underlying value
         constexpr ValueType &underlying_value() noexcept {
-            return value;
+            return storage::value;
         }
 
         /// Get a reference to the underlying value
-        friend constexpr ValueType &underlying_value(strong_typedef &t) {
+        friend constexpr ValueType &
+        underlying_value(strong_typedef &t) noexcept {
             return t.underlying_value();
         }
 
         /// Get a const reference to the underlying value
         friend constexpr ValueType const &
-        underlying_value(strong_typedef const &t) {
+        underlying_value(strong_typedef const &t) noexcept {
             return t.underlying_value();
         }
 
-        /// Get a const rvalue reference to the underlying value
-        friend constexpr ValueType &&underlying_value(strong_typedef &&t) {
+        /// Get an rvalue reference to the underlying value
+        friend constexpr ValueType &&
+        underlying_value(strong_typedef &&t) noexcept {
             return std::move(t.underlying_value());
         }
 
-        /// Get an rvalue reference to the underlying value
+        /// Get a const rvalue reference to the underlying value
         friend constexpr ValueType const &&
-        underlying_value(strong_typedef const &&t) {
+        underlying_value(strong_typedef const &&t) noexcept {
             return std::move(t.underlying_value());
         }
-
-    private:
-        /// The underlying value
-        ValueType value;
     };
 
     /// The underlying value of a value that is not a strong_typedef is just
@@ -94,6 +271,193 @@ namespace jss {
         return std::forward<T>(t);
     }
 
+    /// Trait to determine whether a type is a strong_typedef with exactly the
+    /// same object representation as its underlying value: the same size and
+    /// alignment, standard layout and trivially copyable. Arrays of such a
+    /// strong_typedef can be copied to and from arrays of the underlying
+    /// type with memcpy, and viewed as such arrays. Types that are not
+    /// strong_typedefs are not layout transparent.
+    template <typename T> struct is_layout_transparent : std::false_type {};
+
+    template <typename Tag, typename ValueType, typename... Properties>
+    struct is_layout_transparent<strong_typedef<Tag, ValueType, Properties...>>
+        : std::integral_constant<
+              bool,
+              sizeof(strong_typedef<Tag, ValueType, Properties...>) ==
+                      sizeof(ValueType) &&
+                  alignof(strong_typedef<Tag, ValueType, Properties...>) ==
+                      alignof(ValueType) &&
+                  std::is_standard_layout<
+                      strong_typedef<Tag, ValueType, Properties...>>::value &&
+                  std::is_trivially_copyable<
+                      strong_typedef<Tag, ValueType, Properties...>>::value &&
+                  std::is_trivially_copyable<ValueType>::value> {};
+
+    template <typename T>
+    struct is_layout_transparent<T const> : is_layout_transparent<T> {};
+
+    template <typename T>
+    constexpr bool is_layout_transparent_v= is_layout_transparent<T>::value;
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Multiply two 64-bit values to get a 128-bit product, and return
+        /// the exclusive-or of the high and low halves
+        constexpr std::uint64_t
+        multiply_fold(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+#ifdef __SIZEOF_INT128__
+            __extension__ typedef unsigned __int128 uint128;
+            uint128 const product= static_cast<uint128>(lhs) * rhs;
+            return static_cast<std::uint64_t>(product) ^
+                   static_cast<std::uint64_t>(product >> 64);
+#else
+            std::uint64_t const lhs_low= lhs & 0xffffffff;
+            std::uint64_t const lhs_high= lhs >> 32;
+            std::uint64_t const rhs_low= rhs & 0xffffffff;
+            std::uint64_t const rhs_high= rhs >> 32;
+            std::uint64_t const low_low= lhs_low * rhs_low;
+            std::uint64_t const high_low= lhs_high * rhs_low;
+            std::uint64_t const low_high= lhs_low * rhs_high;
+            std::uint64_t const high_high= lhs_high * rhs_high;
+            std::uint64_t const cross=
+                (low_low >> 32) + (high_low & 0xffffffff) + low_high;
+            std::uint64_t const high=
+                high_high + (high_low >> 32) + (cross >> 32);
+            std::uint64_t const low= (cross << 32) | (low_low & 0xffffffff);
+            return low ^ high;
+#endif
+        }
+    } // namespace detail
+
+    /// Hash policies for the hashable_with property and jss::hash. A hash
+    /// policy is a function object that returns a std::size_t hash of its
+    /// argument. The mixing policies apply a finalizer to the result of
+    /// std::hash, so they work with any type that std::hash supports. They
+    /// are intended for integral IDs: std::hash of an integer is often the
+    /// integer itself, so sequential IDs cluster badly in open-addressing
+    /// hash tables that use the low bits of the hash.
+    namespace hash_policies {
+        /// Use std::hash unchanged. This is the policy of the hashable
+        /// property.
+        struct standard {
+            template <typename T>
+            std::size_t operator()(T const &value) const
+                noexcept(noexcept(std::hash<T>()(value))) {
+                return std::hash<T>()(value);
+            }
+        };
+
+        /// Fibonacci hashing: multiply by 2^64 divided by the golden ratio,
+        /// and fold the high bits of the product into the low bits so that
+        /// tables that mask off the low bits see well-distributed values.
+        /// This is the cheapest mixer.
+        struct fibonacci {
+            template <typename T>
+            std::size_t operator()(T const &value) const
+                noexcept(noexcept(std::hash<T>()(value))) {
+                std::uint64_t const product=
+                    static_cast<std::uint64_t>(std::hash<T>()(value)) *
+                    0x9e3779b97f4a7c15;
+                return static_cast<std::size_t>(product ^ (product >> 32));
+            }
+        };
+
+        /// The avalanche step of XXH3, which ensures every bit of the input
+        /// affects every bit of the result
+        struct xxh3_avalanche {
+            template <typename T>
+            std::size_t operator()(T const &value) const
+                noexcept(noexcept(std::hash<T>()(value))) {
+                std::uint64_t hash=
+                    static_cast<std::uint64_t>(std::hash<T>()(value));
+                hash^= hash >> 37;
+                hash*= 0x165667919e3779f9;
+                hash^= hash >> 32;
+                return static_cast<std::size_t>(hash);
+            }
+        };
+
+        /// The 128-bit multiply-and-fold mixer used by wyhash, which gives
+        /// the best distribution for sequential values where a 64x64->128
+        /// multiply is cheap
+        struct wyhash_mix {
+            template <typename T>
+            std::size_t operator()(T const &value) const
+                noexcept(noexcept(std::hash<T>()(value))) {
+                std::uint64_t const seed=
+                    static_cast<std::uint64_t>(std::hash<T>()(value)) +
+                    0xa0761d6478bd642f;
+                return static_cast<std::size_t>(
+                    detail::multiply_fold(seed, seed ^ 0xe7037ed1a0b428db));
+            }
+        };
+    } // namespace hash_policies
+
+    namespace detail {
+        /// The hash policy chosen by the hashable or hashable_with property
+        /// of a strong_typedef. There is no policy if it has neither.
+        template <typename StrongTypedef, typename= void>
+        struct strong_typedef_hash_policy {};
+
+        template <typename StrongTypedef>
+        struct strong_typedef_hash_policy<
+            StrongTypedef, std::void_t<typename StrongTypedef::hash_policy>> {
+            using type= typename StrongTypedef::hash_policy;
+        };
+
+        /// The default hash policy used by jss::hash<T>
+        template <typename T> struct default_hash_policy {
+            using type= hash_policies::standard;
+        };
+
+        template <typename Tag, typename ValueType, typename... Properties>
+        struct default_hash_policy<
+            strong_typedef<Tag, ValueType, Properties...>>
+            : strong_typedef_hash_policy<
+                  strong_typedef<Tag, ValueType, Properties...>> {};
+
+        /// Check if Property is hashable or hashable_with
+        template <typename Property>
+        struct is_hash_property : std::false_type {};
+
+        template <>
+        struct is_hash_property<strong_typedef_properties::hashable>
+            : std::true_type {};
+
+        template <typename HashPolicy>
+        struct is_hash_property<
+            strong_typedef_properties::hashable_with<HashPolicy>>
+            : std::true_type {};
+
+        /// The number of hashable and hashable_with properties of a
+        /// strong_typedef
+        template <typename StrongTypedef> struct hash_property_count;
+
+        template <typename Tag, typename ValueType, typename... Properties>
+        struct hash_property_count<
+            strong_typedef<Tag, ValueType, Properties...>>
+            : std::integral_constant<
+                  std::size_t,
+                  (std::size_t(0) + ... +
+                   std::size_t(is_hash_property<Properties>::value))> {};
+    } // namespace detail
+
+    /// A hash function object for T that applies HashPolicy to the
+    /// underlying value. For a strong_typedef with the hashable or
+    /// hashable_with property the default policy is the one chosen by the
+    /// property, and for other types it is hash_policies::standard. The
+    /// policy can be specified to choose a different mixer for one
+    /// container, e.g. jss::hash<int, jss::hash_policies::fibonacci>.
+    template <
+        typename T,
+        typename HashPolicy= typename detail::default_hash_policy<T>::type>
+    struct hash {
+        std::size_t operator()(T const &value) const noexcept(
+            noexcept(HashPolicy()(underlying_value(std::declval<T const &>())))) {
+            return HashPolicy()(underlying_value(value));
+        }
+    };
+
     /// Namespace to wrap the property types
     namespace strong_typedef_properties {
         /// Add operator== and operator!= to the strong_typedef
@@ -140,7 +504,8 @@ namespace jss {
         /// Add both pre- and post-increment operators to the strong_typedef
         struct incrementable {
             template <typename Derived, typename ValueType>
-            struct mixin : pre_incrementable::mixin<Derived, ValueType>,
+            struct JSS_EMPTY_BASES mixin
+                : pre_incrementable::mixin<Derived, ValueType>,
                            post_incrementable::mixin<Derived, ValueType> {};
         };
 
@@ -168,7 +533,8 @@ namespace jss {
         /// Add both pre- and post-decrement operators to the strong_typedef
         struct decrementable {
             template <typename Derived, typename ValueType>
-            struct mixin : pre_decrementable::mixin<Derived, ValueType>,
+            struct JSS_EMPTY_BASES mixin
+                : pre_decrementable::mixin<Derived, ValueType>,
                            post_decrementable::mixin<Derived, ValueType> {};
         };
 
@@ -284,58 +650,30 @@ namespace jss {
         }                                                                      \
     };                                                                         \
     struct self_##name {                                                       \
-        template <                                                             \
-            typename Derived, typename ValueType,                              \
-            bool= std::is_literal_type<ValueType>::value>                      \
-        struct mixin {                                                         \
+        template <typename Derived, typename ValueType> struct mixin {         \
             friend constexpr Derived operator op_symbol(                       \
                 Derived const &lhs,                                            \
-                Derived const                                                  \
-                    &rhs) noexcept(noexcept(std::declval<ValueType const &>()  \
-                                                op_symbol std::declval<        \
-                                                    ValueType const &>())) {   \
+                Derived const &rhs) noexcept(noexcept(                         \
+                std::declval<ValueType const &>()                              \
+                    op_symbol std::declval<ValueType const &>())) {            \
                 return Derived{lhs.underlying_value()                          \
                                    op_symbol rhs.underlying_value()};          \
             }                                                                  \
+                                                                               \
             friend Derived &operator JSS_COMPOUND_ASSIGN(op_symbol)(           \
                 Derived &lhs,                                                  \
-                Derived const                                                  \
-                    &rhs) noexcept(noexcept(std::declval<ValueType &>()        \
-                                                JSS_COMPOUND_ASSIGN(op_symbol) \
-                                                    std::declval<              \
-                                                        ValueType const        \
-                                                            &>())) {           \
+                Derived const &rhs) noexcept(noexcept(                         \
+                std::declval<ValueType &>() JSS_COMPOUND_ASSIGN(op_symbol)     \
+                    std::declval<ValueType const &>())) {                      \
                 lhs.underlying_value() JSS_COMPOUND_ASSIGN(op_symbol)          \
                     rhs.underlying_value();                                    \
                 return lhs;                                                    \
             }                                                                  \
         };                                                                     \
-    };                                                                         \
-                                                                               \
-    template <typename Derived, typename ValueType>                            \
-    struct self_##name::mixin<Derived, ValueType, false> {                     \
-        friend Derived                                                         \
-        operator op_symbol(Derived const &lhs, Derived const &rhs) noexcept(   \
-            noexcept(std::declval<ValueType const &>()                         \
-                         op_symbol std::declval<ValueType const &>())) {       \
-            return Derived{lhs.underlying_value()                              \
-                               op_symbol rhs.underlying_value()};              \
-        }                                                                      \
-        friend Derived &operator JSS_COMPOUND_ASSIGN(op_symbol)(               \
-            Derived &lhs,                                                      \
-            Derived const                                                      \
-                &rhs) noexcept(noexcept(std::declval<ValueType &>()            \
-                                            JSS_COMPOUND_ASSIGN(op_symbol)     \
-                                                std::declval<                  \
-                                                    ValueType const &>())) {   \
-            lhs.underlying_value() JSS_COMPOUND_ASSIGN(op_symbol)              \
-                rhs.underlying_value();                                        \
-            return lhs;                                                        \
-        }                                                                      \
     };                                                                         \
     struct name {                                                              \
         template <typename Derived, typename ValueType>                        \
-        struct mixin                                                           \
+        struct JSS_EMPTY_BASES mixin                                           \
             : self_##name::mixin<Derived, ValueType>,                          \
               mixed_##name<ValueType>::template mixin<Derived, ValueType> {};  \
     };
@@ -422,6 +760,7 @@ namespace jss {
                         std::declval<ValueType const &>())) {
                     return lhs.underlying_value() < rhs.underlying_value();
                 }
+
                 friend constexpr bool
                 operator>(Derived const &lhs, Derived const &rhs) noexcept(
                     noexcept(
@@ -429,6 +768,7 @@ namespace jss {
                         std::declval<ValueType const &>())) {
                     return lhs.underlying_value() > rhs.underlying_value();
                 }
+
                 friend constexpr bool
                 operator<=(Derived const &lhs, Derived const &rhs) noexcept(
                     noexcept(
@@ -436,6 +776,7 @@ namespace jss {
                         std::declval<ValueType const &>())) {
                     return lhs.underlying_value() <= rhs.underlying_value();
                 }
+
                 friend constexpr bool
                 operator>=(Derived const &lhs, Derived const &rhs) noexcept(
                     noexcept(
@@ -580,11 +921,43 @@ namespace jss {
             };
         };
 
+        /// Make the default constructor of the strong_typedef trivial if the
+        /// default constructor of the underlying value is. A
+        /// default-initialized value (e.g. a local variable declared without
+        /// an initializer) is then left uninitialized, as for a built-in
+        /// type, and containers of the strong_typedef can use the same bulk
+        /// initialization as containers of the underlying type.
+        /// Value-initialization (e.g. st{} or std::vector<st>(n)) still
+        /// zero-initializes the value.
+        struct trivially_default_constructible {
+            template <typename Derived, typename ValueType> struct mixin {};
+        };
+
         /// Allow this strong_typedef to be used with std::hash
         struct hashable {
             struct base {};
             template <typename Derived, typename ValueType>
-            struct mixin : base {};
+            struct mixin : base {
+                using hash_policy= hash_policies::standard;
+            };
+        };
+
+        /// Allow this strong_typedef to be used with std::hash and jss::hash,
+        /// using HashPolicy to hash the underlying value. HashPolicy can be
+        /// one of the mixers in jss::hash_policies, or any other function
+        /// object that returns a std::size_t hash of the underlying value.
+        /// This cannot be combined with the hashable property, or with
+        /// another hashable_with property.
+        template <typename HashPolicy> struct hashable_with {
+            template <typename Derived, typename ValueType>
+            struct mixin : hashable::base {
+                static_assert(
+                    detail::hash_property_count<Derived>::value == 1,
+                    "A strong_typedef can only have one of the hashable and "
+                    "hashable_with properties");
+
+                using hash_policy= HashPolicy;
+            };
         };
 
         /// Add a stream operator to write the strong_typedef to a std::ostream
@@ -600,11 +973,34 @@ namespace jss {
         /// Combine ordered and equality_comparable
         struct comparable {
             template <typename Derived, typename ValueType>
-            struct mixin
+            struct JSS_EMPTY_BASES mixin
                 : ordered::template mixin<Derived, ValueType>,
                   equality_comparable::template mixin<Derived, ValueType> {};
         };
 
+#if defined(__cpp_impl_three_way_comparison) &&                                \
+    defined(__cpp_lib_three_way_comparison)
+        /// Add the three-way comparison operator to the strong_typedef,
+        /// forwarding to operator<=> of the underlying value. The relational
+        /// operators are rewritten in terms of it, so each comparison
+        /// compares the underlying values once. Only available with C++20.
+        struct three_way_comparable {
+            template <typename Derived, typename ValueType> struct mixin {
+                friend constexpr auto
+                operator<=>(Derived const &lhs, Derived const &rhs) noexcept(
+                    noexcept(
+                        std::declval<ValueType const &>() <=>
+                        std::declval<ValueType const &>()))
+                    -> decltype(
+                        std::declval<ValueType const &>() <=>
+                        std::declval<ValueType const &>()) {
+                    return lhs.underlying_value() <=>
+                           rhs.underlying_value();
+                }
+            };
+        };
+#endif
+
         /// Add a division operation to the strong_typedef that
         /// produces a RatioType instances representing the result
         template <typename RatioType> struct ratio {
@@ -622,25 +1018,15 @@ namespace jss {
 
         /// Add the bitwise not operator to the strong_typedef
         struct bitwise_not {
-            template <
-                typename Derived, typename ValueType,
-                bool= std::is_literal_type<ValueType>::value>
-            struct mixin {
-                friend constexpr Derived operator~(Derived const &lhs) noexcept(
+            template <typename Derived, typename ValueType> struct mixin {
+                friend constexpr Derived
+                operator~(Derived const &lhs) noexcept(
                     noexcept(~std::declval<ValueType const &>())) {
                     return Derived{~lhs.underlying_value()};
                 }
             };
         };
 
-        template <typename Derived, typename ValueType>
-        struct bitwise_not::mixin<Derived, ValueType, false> {
-            friend Derived operator~(Derived const &lhs) noexcept(
-                noexcept(~std::declval<ValueType const &>())) {
-                return Derived{~lhs.underlying_value()};
-            }
-        };
-
         /// Add the bitwise left-shift operator to the strong_typedef
         template <typename Other> struct bitwise_left_shift {
             template <
@@ -730,7 +1116,8 @@ namespace jss {
 
 namespace std {
     /// A specialization of std::hash for those instances of strong_typedef that
-    /// have the hashable property
+    /// have the hashable or hashable_with property. The hash is computed with
+    /// the hash policy chosen by the property.
     template <typename Tag, typename ValueType, typename... Properties>
     struct hash<jss::strong_typedef<Tag, ValueType, Properties...>> {
         template <typename Arg>
@@ -742,8 +1129,8 @@ namespace std {
                     jss::strong_typedef_properties::hashable::base, Arg>::value,
             size_t>::type
         operator()(Arg const &arg) const noexcept(noexcept(
-            std::hash<ValueType>()(std::declval<ValueType const &>()))) {
-            return std::hash<ValueType>()(arg.underlying_value());
+            typename Arg::hash_policy()(std::declval<ValueType const &>()))) {
+            return typename Arg::hash_policy()(arg.underlying_value());
         }
     };
 
@@ -0,0 +1,395 @@
+#ifndef JSS_STRONG_TYPEDEF_ARITHMETIC_HPP
+#define JSS_STRONG_TYPEDEF_ARITHMETIC_HPP
+#include "strong_typedef.hpp"
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Prevent deduction of a function template parameter from an
+        /// argument
+        template <typename T> struct type_identity {
+            using type= T;
+        };
+        template <typename T>
+        using type_identity_t= typename type_identity<T>::type;
+
+        /// An unsigned type at least as wide as T and unsigned int, so that
+        /// arithmetic on it wraps rather than being promoted to int
+        template <typename T>
+        using wrapping_t=
+            std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+
+        /// Arithmetic on T that wraps modulo 2^N
+        template <typename T> constexpr T wrapping_add(T lhs, T rhs) noexcept {
+            return static_cast<T>(
+                static_cast<wrapping_t<T>>(lhs) +
+                static_cast<wrapping_t<T>>(rhs));
+        }
+        template <typename T> constexpr T wrapping_sub(T lhs, T rhs) noexcept {
+            return static_cast<T>(
+                static_cast<wrapping_t<T>>(lhs) -
+                static_cast<wrapping_t<T>>(rhs));
+        }
+        template <typename T> constexpr T wrapping_mul(T lhs, T rhs) noexcept {
+            return static_cast<T>(
+                static_cast<wrapping_t<T>>(lhs) *
+                static_cast<wrapping_t<T>>(rhs));
+        }
+
+        /// Compute lhs+rhs, lhs-rhs or lhs*rhs wrapped to T in result, and
+        /// return true if the true result does not fit in T
+        template <typename T>
+        constexpr bool add_overflow(T lhs, T rhs, T &result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_add_overflow(lhs, rhs, &result);
+#else
+            result= wrapping_add(lhs, rhs);
+            if constexpr(std::is_signed<T>::value)
+                return ((lhs ^ result) & (rhs ^ result)) < 0;
+            else
+                return result < lhs;
+#endif
+        }
+        template <typename T>
+        constexpr bool sub_overflow(T lhs, T rhs, T &result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_sub_overflow(lhs, rhs, &result);
+#else
+            result= wrapping_sub(lhs, rhs);
+            if constexpr(std::is_signed<T>::value)
+                return ((lhs ^ rhs) & (lhs ^ result)) < 0;
+            else
+                return lhs < rhs;
+#endif
+        }
+        template <typename T>
+        constexpr bool mul_overflow(T lhs, T rhs, T &result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_mul_overflow(lhs, rhs, &result);
+#else
+            result= wrapping_mul(lhs, rhs);
+            if(lhs == 0)
+                return false;
+            if constexpr(std::is_signed<T>::value) {
+                if(lhs == -1)
+                    return rhs == std::numeric_limits<T>::min();
+            }
+            return result / lhs != rhs;
+#endif
+        }
+
+        /// The saturation limit when the true result of an operation has
+        /// the same sign as negative_if: the minimum value if negative_if is
+        /// negative, and the maximum value otherwise, computed without a
+        /// branch
+        template <typename T>
+        constexpr T saturation_limit(T negative_if) noexcept {
+            if constexpr(std::is_signed<T>::value) {
+                using unsigned_type= wrapping_t<T>;
+                return static_cast<T>(
+                    static_cast<std::make_unsigned_t<T>>(
+                        (static_cast<std::make_unsigned_t<T>>(negative_if) >>
+                         std::numeric_limits<T>::digits) +
+                        static_cast<unsigned_type>(
+                            std::numeric_limits<T>::max())));
+            } else {
+                return std::numeric_limits<T>::max();
+            }
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        /// A vector of 16 bytes of values of type T, using the compiler's
+        /// vector extensions, so operations on it compile to SIMD
+        /// instructions without relying on the auto-vectorizer, which GCC
+        /// only applies to loops with an unknown trip count at -O3
+        template <typename T> struct simd {
+            typedef T type __attribute__((vector_size(16)));
+        };
+        template <typename T> using simd_t= typename simd<T>::type;
+
+        /// Choose each lane from if_true where mask is all ones, and from
+        /// if_false where it is zero
+        template <typename T, typename Mask>
+        simd_t<T> select_lanes(
+            Mask mask, simd_t<T> if_true, simd_t<T> if_false) noexcept {
+            return (simd_t<T>)(
+                (mask & (Mask)if_true) | (~mask & (Mask)if_false));
+        }
+
+        /// The saturation limit for each lane, as for saturation_limit
+        template <typename T>
+        simd_t<T> saturation_limit_lanes(simd_t<T> negative_if) noexcept {
+            return (negative_if >> std::numeric_limits<T>::digits) ^
+                   std::numeric_limits<T>::max();
+        }
+
+        /// Saturating addition of each lane, in the same way as
+        /// arithmetic_policies::saturating::add
+        template <typename T>
+        simd_t<T> saturating_add_lanes(simd_t<T> lhs, simd_t<T> rhs) noexcept {
+            using unsigned_vector= simd_t<std::make_unsigned_t<T>>;
+            simd_t<T> const result=
+                (simd_t<T>)((unsigned_vector)lhs + (unsigned_vector)rhs);
+            if constexpr(std::is_signed<T>::value) {
+                return select_lanes<T>(
+                    ((lhs ^ result) & (rhs ^ result)) < 0,
+                    saturation_limit_lanes<T>(lhs), result);
+            } else {
+                return result | (simd_t<T>)(result < lhs);
+            }
+        }
+
+        /// Saturating subtraction of each lane, in the same way as
+        /// arithmetic_policies::saturating::sub
+        template <typename T>
+        simd_t<T> saturating_sub_lanes(simd_t<T> lhs, simd_t<T> rhs) noexcept {
+            using unsigned_vector= simd_t<std::make_unsigned_t<T>>;
+            simd_t<T> const result=
+                (simd_t<T>)((unsigned_vector)lhs - (unsigned_vector)rhs);
+            if constexpr(std::is_signed<T>::value) {
+                return select_lanes<T>(
+                    ((lhs ^ rhs) & (lhs ^ result)) < 0,
+                    saturation_limit_lanes<T>(lhs), result);
+            } else {
+                return result & (simd_t<T>)(lhs >= rhs);
+            }
+        }
+
+        /// Apply op to whole vectors of corresponding elements of lhs and
+        /// rhs, storing the results in out, and return the number of
+        /// elements processed
+        template <typename T, typename Op>
+        std::size_t apply_lanes(
+            T const *lhs, T const *rhs, T *out, std::size_t count,
+            Op op) noexcept {
+            using vector= simd_t<T>;
+            constexpr std::size_t lanes= sizeof(vector) / sizeof(T);
+            std::size_t i= 0;
+            for(; i + lanes <= count; i+= lanes) {
+                vector lhs_lanes, rhs_lanes;
+                std::memcpy(&lhs_lanes, lhs + i, sizeof(vector));
+                std::memcpy(&rhs_lanes, rhs + i, sizeof(vector));
+                vector const result= op(lhs_lanes, rhs_lanes);
+                std::memcpy(out + i, &result, sizeof(vector));
+            }
+            return i;
+        }
+#endif
+
+        /// Report overflow in a checked operation
+        [[noreturn]] inline void throw_overflow() {
+            throw std::overflow_error(
+                "jss::strong_typedef: arithmetic overflow");
+        }
+    } // namespace detail
+
+    /// Arithmetic policies for the arithmetic_with property. Each provides
+    /// static functions add, sub and mul, which take and return values of an
+    /// integral type. A policy can also provide static functions
+    /// add_n and sub_n, which jss::bulk::add and jss::bulk::subtract use for
+    /// whole ranges.
+    namespace arithmetic_policies {
+        /// Throw std::overflow_error if the result does not fit in the value
+        /// type. The check uses the compiler's overflow builtins where they
+        /// are available, which compile to the arithmetic instruction
+        /// followed by a branch on the overflow flag that is almost never
+        /// taken.
+        struct checked {
+            template <typename T> static constexpr T add(T lhs, T rhs) {
+                T result{};
+                if(detail::add_overflow(lhs, rhs, result))
+                    detail::throw_overflow();
+                return result;
+            }
+            template <typename T> static constexpr T sub(T lhs, T rhs) {
+                T result{};
+                if(detail::sub_overflow(lhs, rhs, result))
+                    detail::throw_overflow();
+                return result;
+            }
+            template <typename T> static constexpr T mul(T lhs, T rhs) {
+                T result{};
+                if(detail::mul_overflow(lhs, rhs, result))
+                    detail::throw_overflow();
+                return result;
+            }
+        };
+
+        /// Clamp the result to the range of the value type. There is no
+        /// branch: the overflow check and the choice between the result and
+        /// the limit compile to flag or bitwise operations and a conditional
+        /// move, so loops over saturating values can be vectorized.
+        struct saturating {
+            template <typename T>
+            static constexpr T add(T lhs, T rhs) noexcept {
+                T const result= detail::wrapping_add(lhs, rhs);
+                bool overflow;
+                if constexpr(std::is_signed<T>::value)
+                    overflow= ((lhs ^ result) & (rhs ^ result)) < 0;
+                else
+                    overflow= result < lhs;
+                return overflow ? detail::saturation_limit(lhs) : result;
+            }
+            template <typename T>
+            static constexpr T sub(T lhs, T rhs) noexcept {
+                T const result= detail::wrapping_sub(lhs, rhs);
+                if constexpr(std::is_signed<T>::value) {
+                    bool const overflow=
+                        ((lhs ^ rhs) & (lhs ^ result)) < 0;
+                    return overflow ? detail::saturation_limit(lhs) : result;
+                } else {
+                    return lhs < rhs ? T(0) : result;
+                }
+            }
+            template <typename T>
+            static constexpr T mul(T lhs, T rhs) noexcept {
+                T result{};
+                bool const overflow= detail::mul_overflow(lhs, rhs, result);
+                return overflow ? detail::saturation_limit<T>(lhs ^ rhs) :
+                                  result;
+            }
+
+            /// out[i] = add(lhs[i], rhs[i]) for count elements. This is the
+            /// kernel used by jss::bulk::add for ranges of saturating
+            /// values, and uses SIMD instructions where the compiler has
+            /// vector extensions, so it is vectorized at -O2.
+            template <typename T>
+            static void add_n(
+                T const *lhs, T const *rhs, T *out,
+                std::size_t count) noexcept {
+                std::size_t i= 0;
+#if defined(__GNUC__) || defined(__clang__)
+                i= detail::apply_lanes(
+                    lhs, rhs, out, count,
+                    [](detail::simd_t<T> l, detail::simd_t<T> r) {
+                        return detail::saturating_add_lanes<T>(l, r);
+                    });
+#endif
+                for(; i < count; ++i)
+                    out[i]= add(lhs[i], rhs[i]);
+            }
+
+            /// out[i] = sub(lhs[i], rhs[i]) for count elements, as for
+            /// add_n
+            template <typename T>
+            static void sub_n(
+                T const *lhs, T const *rhs, T *out,
+                std::size_t count) noexcept {
+                std::size_t i= 0;
+#if defined(__GNUC__) || defined(__clang__)
+                i= detail::apply_lanes(
+                    lhs, rhs, out, count,
+                    [](detail::simd_t<T> l, detail::simd_t<T> r) {
+                        return detail::saturating_sub_lanes<T>(l, r);
+                    });
+#endif
+                for(; i < count; ++i)
+                    out[i]= sub(lhs[i], rhs[i]);
+            }
+        };
+
+        /// Wrap the result modulo 2^N, where N is the number of bits in the
+        /// value type, for signed as well as unsigned types, so overflow is
+        /// well-defined
+        struct wrapping {
+            template <typename T>
+            static constexpr T add(T lhs, T rhs) noexcept {
+                return detail::wrapping_add(lhs, rhs);
+            }
+            template <typename T>
+            static constexpr T sub(T lhs, T rhs) noexcept {
+                return detail::wrapping_sub(lhs, rhs);
+            }
+            template <typename T>
+            static constexpr T mul(T lhs, T rhs) noexcept {
+                return detail::wrapping_mul(lhs, rhs);
+            }
+        };
+    } // namespace arithmetic_policies
+
+    namespace strong_typedef_properties {
+#define JSS_DEFINE_ARITHMETIC_POLICY_OPS(op_symbol, function)                  \
+    friend constexpr Derived operator op_symbol(                               \
+        Derived const &lhs, Derived const &rhs) noexcept(is_nothrow) {         \
+        return Derived(Policy::function(                                       \
+            lhs.underlying_value(), rhs.underlying_value()));                  \
+    }                                                                          \
+    friend constexpr Derived operator op_symbol(                               \
+        Derived const &lhs, ValueType const &rhs) noexcept(is_nothrow) {       \
+        return Derived(Policy::function(lhs.underlying_value(), rhs));         \
+    }                                                                          \
+    friend constexpr Derived operator op_symbol(                               \
+        ValueType const &lhs, Derived const &rhs) noexcept(is_nothrow) {       \
+        return Derived(Policy::function(lhs, rhs.underlying_value()));         \
+    }                                                                          \
+    friend constexpr Derived &operator JSS_COMPOUND_ASSIGN(op_symbol)(         \
+        Derived &lhs, Derived const &rhs) noexcept(is_nothrow) {               \
+        lhs.underlying_value()= Policy::function(                              \
+            lhs.underlying_value(), rhs.underlying_value());                   \
+        return lhs;                                                            \
+    }                                                                          \
+    friend constexpr Derived &operator JSS_COMPOUND_ASSIGN(op_symbol)(         \
+        Derived &lhs, ValueType const &rhs) noexcept(is_nothrow) {             \
+        lhs.underlying_value()=                                                \
+            Policy::function(lhs.underlying_value(), rhs);                     \
+        return lhs;                                                            \
+    }
+
+        /// The mixin for arithmetic_with<Policy>. The operators are hidden
+        /// friends taking the strong_typedef, like the operators of the
+        /// properties in strong_typedef.hpp, so operands that convert to the
+        /// strong_typedef, such as a std::reference_wrapper, are accepted.
+        template <typename Policy, typename Derived, typename ValueType>
+        struct arithmetic_policy_mixin {
+            static_assert(
+                std::is_integral<ValueType>::value &&
+                    !std::is_same<ValueType, bool>::value,
+                "Arithmetic policies require an integral value type");
+
+            /// The policy, which jss::bulk uses to find its kernels
+            using arithmetic_policy= Policy;
+
+        private:
+            static constexpr bool is_nothrow=
+                noexcept(Policy::add(ValueType(), ValueType())) &&
+                noexcept(Policy::sub(ValueType(), ValueType())) &&
+                noexcept(Policy::mul(ValueType(), ValueType()));
+
+        public:
+            JSS_DEFINE_ARITHMETIC_POLICY_OPS(+, add)
+            JSS_DEFINE_ARITHMETIC_POLICY_OPS(-, sub)
+            JSS_DEFINE_ARITHMETIC_POLICY_OPS(*, mul)
+        };
+
+#undef JSS_DEFINE_ARITHMETIC_POLICY_OPS
+
+        /// Add operator+, operator- and operator* and the corresponding
+        /// compound assignments, where both operands are the strong_typedef,
+        /// or one is the strong_typedef and the other is the underlying
+        /// type. Overflow is handled by Policy, which is one of the
+        /// arithmetic_policies. This is used instead of addable,
+        /// subtractable and multiplicable, and must not be combined with
+        /// them.
+        template <typename Policy> struct arithmetic_with {
+            template <typename Derived, typename ValueType>
+            using mixin= arithmetic_policy_mixin<Policy, Derived, ValueType>;
+        };
+
+        /// Arithmetic that throws std::overflow_error on overflow
+        using checked_arithmetic=
+            arithmetic_with<arithmetic_policies::checked>;
+        /// Arithmetic that clamps the result to the range of the value type
+        using saturating_arithmetic=
+            arithmetic_with<arithmetic_policies::saturating>;
+        /// Arithmetic that wraps on overflow, even for signed value types
+        using wrapping_arithmetic=
+            arithmetic_with<arithmetic_policies::wrapping>;
+    } // namespace strong_typedef_properties
+} // namespace jss
+
+#endif
@@ -0,0 +1,341 @@
+#ifndef JSS_STRONG_TYPEDEF_ATOMIC_HPP
+#define JSS_STRONG_TYPEDEF_ATOMIC_HPP
+#include "strong_typedef.hpp"
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace jss {
+    /// An atomic strong_typedef value. The operations that std::atomic
+    /// provides for all types (load, store, exchange and compare-exchange)
+    /// are always available. The read-modify-write operations are only
+    /// available if the strong_typedef has the corresponding property:
+    ///
+    /// - fetch_add and += require self_addable (e.g. from addable)
+    /// - fetch_sub and -= require self_subtractable
+    /// - fetch_or, fetch_and, fetch_xor and |=, &=, ^= require
+    ///   self_bitwise_or, self_bitwise_and and self_bitwise_xor
+    /// - ++ and -- require pre_incrementable, post_incrementable,
+    ///   pre_decrementable and post_decrementable as for the strong_typedef
+    ///
+    /// The value is held in a std::atomic of the underlying type, so an
+    /// atomic_strong is lock-free wherever that is. For integral underlying
+    /// types the operations use the corresponding std::atomic member
+    /// functions; for other types they are compare-exchange loops that use
+    /// the operators of the strong_typedef.
+    template <typename StrongTypedef> class atomic_strong {
+        using underlying_type= typename StrongTypedef::underlying_value_type;
+
+        /// Check if the strong_typedef S has the property Property
+        template <typename Property, typename S>
+        using has_property= std::is_base_of<
+            typename Property::template mixin<S, underlying_type>, S>;
+
+        template <typename Property, typename S>
+        using enable_if_property_t=
+            std::enable_if_t<has_property<Property, S>::value>;
+
+        /// Integral types can use the std::atomic arithmetic operations
+        static constexpr bool use_atomic_arithmetic=
+            std::is_integral<underlying_type>::value &&
+            !std::is_same<underlying_type, bool>::value;
+
+    public:
+        using value_type= StrongTypedef;
+
+        static constexpr bool is_always_lock_free=
+            std::atomic<underlying_type>::is_always_lock_free;
+
+        /// An atomic_strong holding a value-initialized value
+        atomic_strong() noexcept : value(underlying_type()) {}
+
+        /// An atomic_strong holding desired
+        constexpr atomic_strong(StrongTypedef desired) noexcept :
+            value(desired.underlying_value()) {}
+
+        atomic_strong(atomic_strong const &)= delete;
+        atomic_strong &operator=(atomic_strong const &)= delete;
+
+        bool is_lock_free() const noexcept {
+            return value.is_lock_free();
+        }
+
+        void store(
+            StrongTypedef desired,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            value.store(desired.underlying_value(), order);
+        }
+
+        StrongTypedef
+        load(std::memory_order order= std::memory_order_seq_cst) const
+            noexcept {
+            return StrongTypedef(value.load(order));
+        }
+
+        operator StrongTypedef() const noexcept {
+            return load();
+        }
+
+        StrongTypedef operator=(StrongTypedef desired) noexcept {
+            store(desired);
+            return desired;
+        }
+
+        StrongTypedef exchange(
+            StrongTypedef desired,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            return StrongTypedef(
+                value.exchange(desired.underlying_value(), order));
+        }
+
+        bool compare_exchange_weak(
+            StrongTypedef &expected, StrongTypedef desired,
+            std::memory_order success, std::memory_order failure) noexcept {
+            return value.compare_exchange_weak(
+                expected.underlying_value(), desired.underlying_value(),
+                success, failure);
+        }
+        bool compare_exchange_weak(
+            StrongTypedef &expected, StrongTypedef desired,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            return value.compare_exchange_weak(
+                expected.underlying_value(), desired.underlying_value(),
+                order);
+        }
+
+        bool compare_exchange_strong(
+            StrongTypedef &expected, StrongTypedef desired,
+            std::memory_order success, std::memory_order failure) noexcept {
+            return value.compare_exchange_strong(
+                expected.underlying_value(), desired.underlying_value(),
+                success, failure);
+        }
+        bool compare_exchange_strong(
+            StrongTypedef &expected, StrongTypedef desired,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            return value.compare_exchange_strong(
+                expected.underlying_value(), desired.underlying_value(),
+                order);
+        }
+
+        /// Atomically add arg, and return the old value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_addable, S>>
+        StrongTypedef fetch_add(
+            StrongTypedef const &arg,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(
+                    value.fetch_add(arg.underlying_value(), order));
+            } else {
+                return update(
+                    [&arg](StrongTypedef const &old) { return old + arg; },
+                    order);
+            }
+        }
+
+        /// Atomically subtract arg, and return the old value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_subtractable, S>>
+        StrongTypedef fetch_sub(
+            StrongTypedef const &arg,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(
+                    value.fetch_sub(arg.underlying_value(), order));
+            } else {
+                return update(
+                    [&arg](StrongTypedef const &old) { return old - arg; },
+                    order);
+            }
+        }
+
+        /// Atomically bitwise-or arg into the value, and return the old
+        /// value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_bitwise_or, S>>
+        StrongTypedef fetch_or(
+            StrongTypedef const &arg,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(
+                    value.fetch_or(arg.underlying_value(), order));
+            } else {
+                return update(
+                    [&arg](StrongTypedef const &old) { return old | arg; },
+                    order);
+            }
+        }
+
+        /// Atomically bitwise-and arg into the value, and return the old
+        /// value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_bitwise_and, S>>
+        StrongTypedef fetch_and(
+            StrongTypedef const &arg,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(
+                    value.fetch_and(arg.underlying_value(), order));
+            } else {
+                return update(
+                    [&arg](StrongTypedef const &old) { return old & arg; },
+                    order);
+            }
+        }
+
+        /// Atomically bitwise-xor arg into the value, and return the old
+        /// value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_bitwise_xor, S>>
+        StrongTypedef fetch_xor(
+            StrongTypedef const &arg,
+            std::memory_order order= std::memory_order_seq_cst) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(
+                    value.fetch_xor(arg.underlying_value(), order));
+            } else {
+                return update(
+                    [&arg](StrongTypedef const &old) { return old ^ arg; },
+                    order);
+            }
+        }
+
+        /// Atomically add arg, and return the new value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_addable, S>>
+        StrongTypedef operator+=(StrongTypedef const &arg) noexcept {
+            return fetch_add(arg) + arg;
+        }
+
+        /// Atomically subtract arg, and return the new value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_subtractable, S>>
+        StrongTypedef operator-=(StrongTypedef const &arg) noexcept {
+            return fetch_sub(arg) - arg;
+        }
+
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_bitwise_or, S>>
+        StrongTypedef operator|=(StrongTypedef const &arg) noexcept {
+            return fetch_or(arg) | arg;
+        }
+
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_bitwise_and, S>>
+        StrongTypedef operator&=(StrongTypedef const &arg) noexcept {
+            return fetch_and(arg) & arg;
+        }
+
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::self_bitwise_xor, S>>
+        StrongTypedef operator^=(StrongTypedef const &arg) noexcept {
+            return fetch_xor(arg) ^ arg;
+        }
+
+        /// Atomically increment the value, and return the new value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::pre_incrementable, S>>
+        StrongTypedef operator++() noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(++value);
+            } else {
+                StrongTypedef old= update(
+                    [](StrongTypedef copy) { return ++copy; },
+                    std::memory_order_seq_cst);
+                return ++old;
+            }
+        }
+
+        /// Atomically increment the value, and return the old value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::post_incrementable, S>>
+        StrongTypedef operator++(int) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(value++);
+            } else {
+                return update(
+                    [](StrongTypedef copy) {
+                        copy++;
+                        return copy;
+                    },
+                    std::memory_order_seq_cst);
+            }
+        }
+
+        /// Atomically decrement the value, and return the new value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::pre_decrementable, S>>
+        StrongTypedef operator--() noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(--value);
+            } else {
+                StrongTypedef old= update(
+                    [](StrongTypedef copy) { return --copy; },
+                    std::memory_order_seq_cst);
+                return --old;
+            }
+        }
+
+        /// Atomically decrement the value, and return the old value
+        template <
+            typename S= StrongTypedef,
+            typename= enable_if_property_t<
+                strong_typedef_properties::post_decrementable, S>>
+        StrongTypedef operator--(int) noexcept {
+            if constexpr(use_atomic_arithmetic) {
+                return StrongTypedef(value--);
+            } else {
+                return update(
+                    [](StrongTypedef copy) {
+                        copy--;
+                        return copy;
+                    },
+                    std::memory_order_seq_cst);
+            }
+        }
+
+    private:
+        /// Atomically replace the value with func(old value) using a
+        /// compare-exchange loop, and return the old value
+        template <typename Func>
+        StrongTypedef update(Func func, std::memory_order order) noexcept {
+            underlying_type old= value.load(std::memory_order_relaxed);
+            while(!value.compare_exchange_weak(
+                old, func(StrongTypedef(old)).underlying_value(), order,
+                std::memory_order_relaxed)) {
+            }
+            return StrongTypedef(old);
+        }
+
+        std::atomic<underlying_type> value;
+    };
+} // namespace jss
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef JSS_STRONG_TYPEDEF_BOUNDED_HPP
+#define JSS_STRONG_TYPEDEF_BOUNDED_HPP
+#include "strong_typedef.hpp"
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+/// Tell the optimizer that expr is true, without evaluating it at runtime.
+/// If expr is false when this is reached, the behaviour is undefined.
+#if __cplusplus > 201703L && defined(__has_cpp_attribute)
+#if __has_cpp_attribute(assume) >= 202207L
+#define JSS_ASSUME(expr) [[assume(expr)]]
+#endif
+#endif
+#ifndef JSS_ASSUME
+#if defined(__clang__)
+#define JSS_ASSUME(expr) __builtin_assume(expr)
+#elif defined(_MSC_VER)
+#define JSS_ASSUME(expr) __assume(expr)
+#elif defined(__GNUC__)
+#define JSS_ASSUME(expr)                                                       \
+    do {                                                                       \
+        if(!(expr))                                                            \
+            __builtin_unreachable();                                           \
+    } while(0)
+#else
+#define JSS_ASSUME(expr) ((void)0)
+#endif
+#endif
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if the bound of a bounded property can be represented
+        /// exactly in ValueType. Arithmetic bounds are checked against the
+        /// limits of ValueType before they are converted, and must convert
+        /// back to the same value, so neither truncation nor rounding is
+        /// allowed. Other bounds are only required to convert.
+        template <typename ValueType, typename Bound>
+        constexpr bool bound_representable(Bound bound) noexcept {
+            if constexpr(
+                std::is_integral<Bound>::value &&
+                std::is_integral<ValueType>::value) {
+                using limits= std::numeric_limits<ValueType>;
+                if(bound < Bound())
+                    return std::is_signed<ValueType>::value &&
+                           static_cast<long long>(bound) >=
+                               static_cast<long long>(limits::min());
+                return static_cast<unsigned long long>(bound) <=
+                       static_cast<unsigned long long>(limits::max());
+            } else if constexpr(
+                std::is_arithmetic<Bound>::value &&
+                std::is_arithmetic<ValueType>::value) {
+                using limits= std::numeric_limits<ValueType>;
+                long double const wide= static_cast<long double>(bound);
+                return !(wide < static_cast<long double>(limits::lowest())) &&
+                       !(static_cast<long double>(limits::max()) < wide) &&
+                       static_cast<Bound>(static_cast<ValueType>(bound)) ==
+                           bound;
+            } else {
+                return std::is_convertible<Bound, ValueType>::value;
+            }
+        }
+    } // namespace detail
+
+    namespace strong_typedef_properties {
+        /// Restrict the values of this strong_typedef to the closed range
+        /// [Min,Max]. Constructing a strong_typedef from a value outside the
+        /// range throws std::out_of_range, or fails to compile in a constant
+        /// expression.
+        ///
+        /// The bounded_value() member function returns the value and tells
+        /// the optimizer that it is in the range, so the compiler can remove
+        /// range checks and narrow switch statements that use it. Operators
+        /// and writes through underlying_value() are not checked: reading a
+        /// value that has been put out of range this way with
+        /// bounded_value() is undefined behaviour, and is caught by an
+        /// assertion in debug builds.
+        template <auto Min, auto Max> struct bounded {
+            static_assert(!(Max < Min), "The bounds must not be reversed");
+
+            /// Throw std::out_of_range if value is not in [Min,Max]
+            template <typename ValueType>
+            static constexpr void validate_value(ValueType const &value) {
+                if(value < static_cast<ValueType>(Min) ||
+                   static_cast<ValueType>(Max) < value)
+                    throw std::out_of_range(
+                        "jss::strong_typedef: value out of bounds");
+            }
+
+            template <typename Derived, typename ValueType> struct mixin {
+                static_assert(
+                    detail::bound_representable<ValueType>(Min) &&
+                        detail::bound_representable<ValueType>(Max),
+                    "The bounds must be representable in the value type");
+
+                /// The smallest allowed value
+                static constexpr ValueType min_value=
+                    static_cast<ValueType>(Min);
+                /// The largest allowed value
+                static constexpr ValueType max_value=
+                    static_cast<ValueType>(Max);
+
+                /// The underlying value, which the optimizer can assume is
+                /// in [min_value,max_value]
+                constexpr ValueType const &bounded_value() const noexcept {
+                    ValueType const &value=
+                        static_cast<Derived const &>(*this).underlying_value();
+                    assert(!(value < min_value) && !(max_value < value));
+                    JSS_ASSUME(!(value < min_value) && !(max_value < value));
+                    return value;
+                }
+            };
+        };
+    } // namespace strong_typedef_properties
+} // namespace jss
+
+#endif
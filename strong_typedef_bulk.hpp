@@ -0,0 +1,495 @@
+#ifndef JSS_STRONG_TYPEDEF_BULK_HPP
+#define JSS_STRONG_TYPEDEF_BULK_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace jss {
+    /// Operations on contiguous ranges of values, such as std::vector or
+    /// std::array of strong_typedef instances.
+    ///
+    /// Each operation is only available if the corresponding scalar
+    /// operation is valid on the element types, so the properties of a
+    /// strong_typedef apply to the bulk operations in exactly the same way as
+    /// to the scalar ones: bulk::multiply on two ranges of a strong_typedef
+    /// requires self_multiplicable, bulk::add of a range of one strong_typedef
+    /// to a range of another requires mixed_addable, and so on.
+    ///
+    /// The loops are written so that the compiler can vectorize them for
+    /// arithmetic underlying types: the element operations are the
+    /// strong_typedef operators, which inline to the same instructions as
+    /// the raw arithmetic, each output element depends only on the
+    /// corresponding input elements, and reductions use several independent
+    /// accumulators so that they are not serialized on a single dependency
+    /// chain.
+    ///
+    /// For all operations, each output range must have at least as many
+    /// elements as the first input range, and each other input range must
+    /// have at least as many elements as the first input range.
+    namespace bulk {
+        /// Internal implementation namespace
+        namespace detail {
+            /// The number of independent accumulators used by reductions. The
+            /// reductions initialize each accumulator explicitly, so changing
+            /// this requires changing them too
+            constexpr std::size_t accumulator_count= 4;
+
+            using jss::detail::element_t;
+            using jss::detail::is_contiguous_range;
+
+            /// An operand that is either a contiguous range, accessed
+            /// element by element, or a single value that is used for every
+            /// element
+            template <
+                typename T,
+                bool= is_contiguous_range<std::remove_reference_t<T>>::value>
+            struct operand {
+                using pointer=
+                    decltype(std::data(std::declval<T &>()));
+                using reference= decltype(*std::declval<pointer>());
+
+                pointer data;
+
+                explicit constexpr operand(T &range) noexcept :
+                    data(std::data(range)) {}
+
+                constexpr reference operator[](std::size_t i) const noexcept {
+                    return data[i];
+                }
+            };
+
+            template <typename T> struct operand<T, false> {
+                using reference= T const &;
+
+                T const &value;
+
+                explicit constexpr operand(T const &value_) noexcept :
+                    value(value_) {}
+
+                constexpr reference operator[](std::size_t) const noexcept {
+                    return value;
+                }
+            };
+
+            /// The element type accessed through an operand
+            template <typename T>
+            using operand_element_t=
+                std::remove_cv_t<std::remove_reference_t<
+                    typename operand<T>::reference>>;
+
+            /// Apply func element-wise, writing the results to out
+            template <typename Out, typename Func, typename... Operands>
+            void apply(
+                std::size_t count, Out *out, Func &func,
+                Operands const &... operands) {
+                for(std::size_t i= 0; i < count; ++i)
+                    out[i]= func(operands[i]...);
+            }
+
+            /// Check that the result of an operation can be stored in the
+            /// output range
+            template <typename OutRange, typename Result>
+            using enable_if_storable_t= std::enable_if_t<
+                is_contiguous_range<std::remove_reference_t<OutRange>>::
+                        value &&
+                    std::is_assignable<
+                        element_t<std::remove_reference_t<OutRange>> &,
+                        Result>::value,
+                int>;
+
+            /// Function objects for the built-in operators
+            struct plus {
+                template <typename L, typename R>
+                constexpr auto operator()(L const &lhs, R const &rhs) const
+                    -> decltype(lhs + rhs) {
+                    return lhs + rhs;
+                }
+            };
+            struct minus {
+                template <typename L, typename R>
+                constexpr auto operator()(L const &lhs, R const &rhs) const
+                    -> decltype(lhs - rhs) {
+                    return lhs - rhs;
+                }
+            };
+            struct multiplies {
+                template <typename L, typename R>
+                constexpr auto operator()(L const &lhs, R const &rhs) const
+                    -> decltype(lhs * rhs) {
+                    return lhs * rhs;
+                }
+            };
+            struct divides {
+                template <typename L, typename R>
+                constexpr auto operator()(L const &lhs, R const &rhs) const
+                    -> decltype(lhs / rhs) {
+                    return lhs / rhs;
+                }
+            };
+            struct multiply_add {
+                template <typename A, typename B, typename C>
+                constexpr auto
+                operator()(A const &a, B const &b, C const &c) const
+                    -> decltype(a * b + c) {
+                    return a * b + c;
+                }
+            };
+
+            /// The result type of applying Op to the elements of the
+            /// operands
+            template <typename Op, typename... Operands>
+            using result_t= decltype(std::declval<Op const &>()(
+                std::declval<operand_element_t<Operands> const &>()...));
+
+            /// Kernels for adding and subtracting whole ranges. The
+            /// arithmetic policy of a strong_typedef can provide them as
+            /// static member functions add_n and sub_n that take pointers
+            /// to the underlying values, as arithmetic_policies::saturating
+            /// does, and they are used instead of the element-by-element
+            /// loop when both operands and the output are ranges of the same
+            /// layout-transparent strong_typedef.
+            struct add_kernel {
+                template <typename Policy, typename T>
+                static auto
+                apply(T const *lhs, T const *rhs, T *out, std::size_t count)
+                    -> decltype(Policy::add_n(lhs, rhs, out, count)) {
+                    return Policy::add_n(lhs, rhs, out, count);
+                }
+            };
+            struct sub_kernel {
+                template <typename Policy, typename T>
+                static auto
+                apply(T const *lhs, T const *rhs, T *out, std::size_t count)
+                    -> decltype(Policy::sub_n(lhs, rhs, out, count)) {
+                    return Policy::sub_n(lhs, rhs, out, count);
+                }
+            };
+
+            /// The element type of a contiguous range, without const
+            template <typename Range>
+            using value_element_t= std::remove_cv_t<element_t<Range>>;
+
+            /// Check if the arithmetic policy of the elements of Lhs
+            /// provides Kernel, and Lhs, Rhs and Out are ranges of the same
+            /// layout-transparent strong_typedef
+            template <
+                typename Kernel, typename Lhs, typename Rhs, typename Out,
+                typename= void>
+            struct has_policy_kernel : std::false_type {};
+
+            template <
+                typename Kernel, typename Lhs, typename Rhs, typename Out>
+            struct has_policy_kernel<
+                Kernel, Lhs, Rhs, Out,
+                std::void_t<
+                    element_t<Rhs>, element_t<Out>,
+                    decltype(Kernel::template apply<
+                             typename value_element_t<Lhs>::arithmetic_policy>(
+                        std::declval<typename value_element_t<
+                            Lhs>::underlying_value_type const *>(),
+                        std::declval<typename value_element_t<
+                            Lhs>::underlying_value_type const *>(),
+                        std::declval<typename value_element_t<
+                            Lhs>::underlying_value_type *>(),
+                        std::size_t()))>>
+                : std::conjunction<
+                      std::is_same<
+                          value_element_t<Lhs>, value_element_t<Rhs>>,
+                      std::is_same<value_element_t<Lhs>, element_t<Out>>,
+                      is_layout_transparent<element_t<Out>>> {};
+
+            /// Apply Kernel to the underlying values of lhs, rhs and out
+            template <
+                typename Kernel, typename Lhs, typename Rhs, typename Out>
+            void apply_policy_kernel(Lhs const &lhs, Rhs const &rhs, Out &out) {
+                using element= value_element_t<Lhs const>;
+                using value_type= typename element::underlying_value_type;
+                Kernel::template apply<typename element::arithmetic_policy>(
+                    reinterpret_cast<value_type const *>(std::data(lhs)),
+                    reinterpret_cast<value_type const *>(std::data(rhs)),
+                    reinterpret_cast<value_type *>(std::data(out)),
+                    std::size(lhs));
+            }
+        } // namespace detail
+
+        /// Apply func to each element of in, storing the results in the
+        /// corresponding elements of out
+        template <
+            typename InRange, typename OutRange, typename Func,
+            detail::enable_if_storable_t<
+                OutRange,
+                decltype(std::declval<Func &>()(
+                    std::declval<detail::element_t<InRange const> &>()))> = 0>
+        void transform(InRange const &in, OutRange &&out, Func func) {
+            detail::apply(
+                std::size(in), std::data(out), func,
+                detail::operand<InRange const>(in));
+        }
+
+        /// Apply func to each pair of corresponding elements of lhs and rhs,
+        /// storing the results in the corresponding elements of out. Either
+        /// lhs or rhs may be a single value rather than a range, in which
+        /// case that value is used for every element.
+        template <
+            typename Lhs, typename Rhs, typename OutRange, typename Func,
+            detail::enable_if_storable_t<
+                OutRange,
+                decltype(std::declval<Func &>()(
+                    std::declval<
+                        detail::operand_element_t<Lhs const> const &>(),
+                    std::declval<detail::operand_element_t<Rhs const> const
+                                     &>()))> = 0>
+        void
+        transform(Lhs const &lhs, Rhs const &rhs, OutRange &&out, Func func) {
+            static_assert(
+                detail::is_contiguous_range<Lhs const>::value ||
+                    detail::is_contiguous_range<Rhs const>::value,
+                "At least one operand must be a range");
+            std::size_t count;
+            if constexpr(detail::is_contiguous_range<Lhs const>::value)
+                count= std::size(lhs);
+            else
+                count= std::size(rhs);
+            detail::apply(
+                count, std::data(out), func,
+                detail::operand<Lhs const>(lhs),
+                detail::operand<Rhs const>(rhs));
+        }
+
+        /// out[i] = lhs[i] + rhs[i]
+        template <
+            typename Lhs, typename Rhs, typename OutRange,
+            detail::enable_if_storable_t<
+                OutRange, detail::result_t<detail::plus, Lhs const, Rhs const>> =
+                0>
+        void add(Lhs const &lhs, Rhs const &rhs, OutRange &&out) {
+            if constexpr(detail::has_policy_kernel<
+                             detail::add_kernel, Lhs const, Rhs const,
+                             std::remove_reference_t<OutRange>>::value)
+                detail::apply_policy_kernel<detail::add_kernel>(lhs, rhs, out);
+            else
+                bulk::transform(lhs, rhs, out, detail::plus());
+        }
+
+        /// out[i] = lhs[i] - rhs[i]
+        template <
+            typename Lhs, typename Rhs, typename OutRange,
+            detail::enable_if_storable_t<
+                OutRange,
+                detail::result_t<detail::minus, Lhs const, Rhs const>> = 0>
+        void subtract(Lhs const &lhs, Rhs const &rhs, OutRange &&out) {
+            if constexpr(detail::has_policy_kernel<
+                             detail::sub_kernel, Lhs const, Rhs const,
+                             std::remove_reference_t<OutRange>>::value)
+                detail::apply_policy_kernel<detail::sub_kernel>(lhs, rhs, out);
+            else
+                bulk::transform(lhs, rhs, out, detail::minus());
+        }
+
+        /// out[i] = lhs[i] * rhs[i]
+        template <
+            typename Lhs, typename Rhs, typename OutRange,
+            detail::enable_if_storable_t<
+                OutRange,
+                detail::result_t<detail::multiplies, Lhs const, Rhs const>> =
+                0>
+        void multiply(Lhs const &lhs, Rhs const &rhs, OutRange &&out) {
+            bulk::transform(lhs, rhs, out, detail::multiplies());
+        }
+
+        /// out[i] = lhs[i] / rhs[i]
+        template <
+            typename Lhs, typename Rhs, typename OutRange,
+            detail::enable_if_storable_t<
+                OutRange,
+                detail::result_t<detail::divides, Lhs const, Rhs const>> = 0>
+        void divide(Lhs const &lhs, Rhs const &rhs, OutRange &&out) {
+            bulk::transform(lhs, rhs, out, detail::divides());
+        }
+
+        /// out[i] = a[i] * b[i] + c[i]. Any of a, b or c may be a single
+        /// value rather than a range, provided a is a range.
+        template <
+            typename A, typename B, typename C, typename OutRange,
+            detail::enable_if_storable_t<
+                OutRange, detail::result_t<
+                              detail::multiply_add, A const, B const,
+                              C const>> = 0>
+        void fused_multiply_add(
+            A const &a, B const &b, C const &c, OutRange &&out) {
+            static_assert(
+                detail::is_contiguous_range<A const>::value,
+                "The first operand must be a range");
+            detail::multiply_add func;
+            detail::apply(
+                std::size(a), std::data(out), func,
+                detail::operand<A const>(a), detail::operand<B const>(b),
+                detail::operand<C const>(c));
+        }
+
+        namespace detail {
+            /// Check if the partial sums of reduce can be accumulated in
+            /// several values of type T: each must be constructible from an
+            /// element, and the partial sums must be addable
+            template <typename T, typename Element, typename= void>
+            struct can_interleave_sums : std::false_type {};
+
+            template <typename T, typename Element>
+            struct can_interleave_sums<
+                T, Element,
+                std::enable_if_t<
+                    std::is_constructible<T, Element &>::value &&
+                    std::is_assignable<
+                        T &, decltype(std::declval<T const &>() +
+                                      std::declval<T const &>())>::value>>
+                : std::true_type {};
+        } // namespace detail
+
+        /// Sum the elements of range, starting from init. Requires that each
+        /// element can be added to a T. If a T can also be constructed from
+        /// an element, and added to another T, the elements are summed in
+        /// several interleaved partial sums, the first of which starts from
+        /// init, so the result for floating point values may differ slightly
+        /// from a sequential sum. Otherwise they are added to init in turn.
+        template <
+            typename Range, typename T,
+            typename= std::enable_if_t<std::is_assignable<
+                T &, decltype(std::declval<T const &>() +
+                              std::declval<detail::element_t<Range const> &>())>::
+                                           value>>
+        T reduce(Range const &range, T init) {
+            auto const *data= std::data(range);
+            std::size_t const count= std::size(range);
+            std::size_t const n= detail::accumulator_count;
+            if constexpr(detail::can_interleave_sums<
+                             T, detail::element_t<Range const>>::value) {
+                if(count >= n) {
+                    T partial[n]= {init, T(data[1]), T(data[2]), T(data[3])};
+                    partial[0]= partial[0] + data[0];
+                    std::size_t i= n;
+                    for(; i + n <= count; i+= n) {
+                        for(std::size_t j= 0; j < n; ++j)
+                            partial[j]= partial[j] + data[i + j];
+                    }
+                    for(; i < count; ++i)
+                        partial[0]= partial[0] + data[i];
+                    return (partial[0] + partial[1]) +
+                           (partial[2] + partial[3]);
+                }
+            }
+            for(std::size_t i= 0; i < count; ++i)
+                init= init + data[i];
+            return init;
+        }
+
+        /// Sum the elements of range, starting from a default-constructed
+        /// value
+        template <typename Range>
+        auto reduce(Range const &range)
+            -> decltype(bulk::reduce(
+                range, std::remove_cv_t<detail::element_t<Range const>>())) {
+            return bulk::reduce(
+                range, std::remove_cv_t<detail::element_t<Range const>>());
+        }
+
+        namespace detail {
+            /// Find the smallest or largest element of a non-empty range,
+            /// using the < operator of the element type
+            template <bool Largest, typename Range>
+            auto extreme(Range const &range) {
+                using value_type= std::remove_cv_t<element_t<Range const>>;
+                auto const *data= std::data(range);
+                std::size_t const count= std::size(range);
+                assert(count != 0);
+                auto better= [](value_type const &candidate,
+                                value_type const &current) -> bool {
+                    if constexpr(Largest)
+                        return current < candidate;
+                    else
+                        return candidate < current;
+                };
+                constexpr std::size_t n= accumulator_count;
+                if(count < n) {
+                    value_type result= data[0];
+                    for(std::size_t i= 1; i < count; ++i)
+                        result= better(data[i], result) ? data[i] : result;
+                    return result;
+                }
+                value_type partial[n]= {data[0], data[1], data[2], data[3]};
+                std::size_t i= n;
+                for(; i + n <= count; i+= n) {
+                    for(std::size_t j= 0; j < n; ++j)
+                        partial[j]= better(data[i + j], partial[j]) ?
+                                        data[i + j] :
+                                        partial[j];
+                }
+                for(; i < count; ++i)
+                    partial[0]= better(data[i], partial[0]) ? data[i] :
+                                                              partial[0];
+                for(std::size_t j= 1; j < n; ++j)
+                    partial[0]= better(partial[j], partial[0]) ? partial[j] :
+                                                                 partial[0];
+                return partial[0];
+            }
+
+            template <typename Range>
+            using enable_if_ordered_t= std::enable_if_t<std::is_convertible<
+                decltype(
+                    std::declval<element_t<Range const> &>() <
+                    std::declval<element_t<Range const> &>()),
+                bool>::value>;
+        } // namespace detail
+
+        /// The smallest element of range, which must not be empty: this is
+        /// only checked with assert. Requires the element type to be ordered
+        template <
+            typename Range,
+            typename= detail::enable_if_ordered_t<Range>>
+        auto minimum(Range const &range) {
+            return detail::extreme<false>(range);
+        }
+
+        /// The largest element of range, which must not be empty: this is
+        /// only checked with assert. Requires the element type to be ordered
+        template <
+            typename Range,
+            typename= detail::enable_if_ordered_t<Range>>
+        auto maximum(Range const &range) {
+            return detail::extreme<true>(range);
+        }
+
+        /// Set mask[i] to compare(lhs[i], rhs[i]), or compare(lhs[i], rhs) if
+        /// rhs is a single value. The mask is a range of bool or another type
+        /// that a bool can be assigned to. Requires that the comparison is
+        /// valid for the element types, e.g. a strong_typedef used with
+        /// std::less<> must be ordered.
+        template <
+            typename Lhs, typename Rhs, typename MaskRange,
+            typename Compare,
+            detail::enable_if_storable_t<MaskRange, bool> = 0,
+            typename= std::enable_if_t<
+                detail::is_contiguous_range<Lhs const>::value &&
+                std::is_convertible<
+                    decltype(std::declval<Compare &>()(
+                        std::declval<detail::element_t<Lhs const> &>(),
+                        std::declval<
+                            detail::operand_element_t<Rhs const> const &>())),
+                    bool>::value>>
+        void compare(
+            Lhs const &lhs, Rhs const &rhs, MaskRange &&mask, Compare comp) {
+            auto func= [&comp](auto const &l, auto const &r) -> bool {
+                return comp(l, r);
+            };
+            detail::apply(
+                std::size(lhs), std::data(mask), func,
+                detail::operand<Lhs const>(lhs),
+                detail::operand<Rhs const>(rhs));
+        }
+    } // namespace bulk
+} // namespace jss
+
+#endif
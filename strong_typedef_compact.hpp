@@ -0,0 +1,182 @@
+#ifndef JSS_STRONG_TYPEDEF_COMPACT_HPP
+#define JSS_STRONG_TYPEDEF_COMPACT_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace jss {
+    namespace strong_typedef_properties {
+        /// Allow values of this strong_typedef to be stored in the smaller
+        /// integer type NarrowT with jss::compact. The strong_typedef itself
+        /// still holds a ValueType, so underlying_value() and the operators
+        /// are unchanged.
+        template <typename NarrowT> struct stored_as {
+            template <typename Derived, typename ValueType> struct mixin {
+                static_assert(
+                    std::is_integral<ValueType>::value &&
+                        std::is_integral<NarrowT>::value,
+                    "Compact storage requires integral types");
+                static_assert(
+                    sizeof(NarrowT) <= sizeof(ValueType),
+                    "The compact storage type must not be larger than the "
+                    "value type");
+
+                using compact_storage_type= NarrowT;
+            };
+        };
+    } // namespace strong_typedef_properties
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if T is a strong_typedef with the stored_as property
+        template <typename T, typename= void>
+        struct has_compact_storage : std::false_type {};
+
+        template <typename T>
+        struct has_compact_storage<
+            T, std::void_t<
+                   typename T::underlying_value_type,
+                   typename T::compact_storage_type>>
+            : std::is_base_of<
+                  typename strong_typedef_properties::stored_as<
+                      typename T::compact_storage_type>::
+                      template mixin<T, typename T::underlying_value_type>,
+                  T> {};
+
+        /// Check if value can be converted to To without changing it. This
+        /// uses & rather than && so that there is no branch.
+        template <typename To, typename From>
+        constexpr bool fits_in(From value) noexcept {
+            return (static_cast<From>(static_cast<To>(value)) == value) &
+                   ((value < From()) == (static_cast<To>(value) < To()));
+        }
+
+        /// Report a value that does not fit in its compact storage
+        [[noreturn]] inline void throw_does_not_fit() {
+            throw std::out_of_range(
+                "jss::compact: value does not fit in the storage type");
+        }
+    } // namespace detail
+
+    /// A value of StrongTypedef held in its compact storage type, as given
+    /// by the stored_as property. This is a trivially copyable type that is
+    /// the size of the storage type, for use as the element type of large
+    /// arrays: std::vector<compact<order_id>> with a 16-bit storage type
+    /// takes half the memory of std::vector<order_id> with a 32-bit value
+    /// type.
+    ///
+    /// A compact is constructed from a StrongTypedef, and throws
+    /// std::out_of_range if the value does not fit in the storage type. It
+    /// converts back to a StrongTypedef implicitly, so the operations of
+    /// StrongTypedef apply to the widened value.
+    template <typename StrongTypedef> class compact {
+        static_assert(
+            detail::has_compact_storage<StrongTypedef>::value,
+            "The strong_typedef must have the stored_as property");
+
+        using value_type= typename StrongTypedef::underlying_value_type;
+
+    public:
+        using strong_typedef_type= StrongTypedef;
+        using storage_type= typename StrongTypedef::compact_storage_type;
+
+        /// A default-constructed compact is uninitialized, so arrays of them
+        /// can be allocated without writing to every element
+        compact()= default;
+
+        /// Store value, throwing std::out_of_range if it does not fit
+        constexpr compact(StrongTypedef const &value) :
+            stored(narrow(value.underlying_value())) {}
+
+        /// The stored value as a StrongTypedef
+        constexpr operator StrongTypedef() const {
+            return StrongTypedef(static_cast<value_type>(stored));
+        }
+
+        /// The stored value as a StrongTypedef
+        constexpr StrongTypedef value() const {
+            return StrongTypedef(static_cast<value_type>(stored));
+        }
+
+        /// The stored value in the storage type
+        constexpr storage_type stored_value() const noexcept {
+            return stored;
+        }
+
+        /// A compact holding the specified value of the storage type, such
+        /// as one previously obtained from stored_value()
+        static constexpr compact
+        from_stored_value(storage_type value) noexcept {
+            compact result{};
+            result.stored= value;
+            return result;
+        }
+
+    private:
+        static constexpr storage_type narrow(value_type value) {
+            if(!detail::fits_in<storage_type>(value))
+                detail::throw_does_not_fit();
+            return static_cast<storage_type>(value);
+        }
+
+        storage_type stored;
+    };
+
+    /// Copy the values of a contiguous range of StrongTypedef into a
+    /// contiguous range of compact<StrongTypedef>, which must have at least
+    /// as many elements. All the values are checked before any are copied,
+    /// so if one does not fit, std::out_of_range is thrown and out is
+    /// unchanged. The check and the copy are separate branch-free loops,
+    /// which the compiler can vectorize.
+    template <
+        typename InRange, typename OutRange,
+        typename StrongTypedef= std::remove_cv_t<detail::element_t<InRange>>,
+        typename= std::enable_if_t<
+            detail::has_compact_storage<StrongTypedef>::value &&
+            std::is_same<
+                detail::element_t<std::remove_reference_t<OutRange>>,
+                compact<StrongTypedef>>::value>>
+    void narrow_copy(InRange const &in, OutRange &&out) {
+        using storage_type= typename StrongTypedef::compact_storage_type;
+        std::size_t const count= std::size(in);
+        assert(std::size(out) >= count);
+        StrongTypedef const *const source= std::data(in);
+        std::size_t misfits= 0;
+        for(std::size_t i= 0; i < count; ++i)
+            misfits+= !detail::fits_in<storage_type>(
+                source[i].underlying_value());
+        if(misfits)
+            detail::throw_does_not_fit();
+        compact<StrongTypedef> *const dest= std::data(out);
+        for(std::size_t i= 0; i < count; ++i)
+            dest[i]= compact<StrongTypedef>::from_stored_value(
+                static_cast<storage_type>(source[i].underlying_value()));
+    }
+
+    /// Copy the values of a contiguous range of compact<StrongTypedef> into
+    /// a contiguous range of StrongTypedef, which must have at least as
+    /// many elements
+    template <
+        typename InRange, typename OutRange,
+        typename Compact= std::remove_cv_t<detail::element_t<InRange>>,
+        typename StrongTypedef= typename Compact::strong_typedef_type,
+        typename= std::enable_if_t<
+            std::is_same<Compact, compact<StrongTypedef>>::value &&
+            std::is_same<
+                detail::element_t<std::remove_reference_t<OutRange>>,
+                StrongTypedef>::value>>
+    void widen_copy(InRange const &in, OutRange &&out) {
+        std::size_t const count= std::size(in);
+        assert(std::size(out) >= count);
+        Compact const *const source= std::data(in);
+        StrongTypedef *const dest= std::data(out);
+        for(std::size_t i= 0; i < count; ++i)
+            dest[i]= source[i].value();
+    }
+} // namespace jss
+
+#endif
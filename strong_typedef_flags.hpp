@@ -0,0 +1,282 @@
+#ifndef JSS_STRONG_TYPEDEF_FLAGS_HPP
+#define JSS_STRONG_TYPEDEF_FLAGS_HPP
+#include "strong_typedef.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#if __cplusplus > 201703L && defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if T is a strong_typedef whose values can name the bits of
+        /// a flags set: the underlying type must be integral or an
+        /// enumeration
+        template <typename T, typename= void>
+        struct is_flag_type : std::false_type {};
+
+        template <typename T>
+        struct is_flag_type<T, std::void_t<typename T::underlying_value_type>>
+            : std::integral_constant<
+                  bool,
+                  std::is_integral<typename T::underlying_value_type>::value ||
+                      std::is_enum<typename T::underlying_value_type>::value> {
+        };
+
+        /// The number of set bits in value, which compiles to a single
+        /// instruction where the target has one
+        constexpr int popcount(std::uint64_t value) noexcept {
+#ifdef __cpp_lib_bitops
+            return std::popcount(value);
+#elif defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(value);
+#else
+            value= value - ((value >> 1) & 0x5555555555555555);
+            value= (value & 0x3333333333333333) +
+                   ((value >> 2) & 0x3333333333333333);
+            value= (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0f;
+            return static_cast<int>((value * 0x0101010101010101) >> 56);
+#endif
+        }
+
+        /// The number of trailing zero bits in value, which must not be
+        /// zero
+        constexpr int countr_zero(std::uint64_t value) noexcept {
+#ifdef __cpp_lib_bitops
+            return std::countr_zero(value);
+#elif defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(value);
+#else
+            return popcount((value & (~value + 1)) - 1);
+#endif
+        }
+    } // namespace detail
+
+    /// A set of flags named by values of the strong_typedef Flag, whose
+    /// underlying value is the position of the flag's bit, from 0 to
+    /// Size-1. The default Size of 64 holds the set in a single 64-bit word,
+    /// so test, set and reset are single bitwise instructions and count is a
+    /// single popcount. Larger sizes, such as 256, use an array of words.
+    /// Every operation on whole sets is a fixed-length loop over that array,
+    /// which the compiler unrolls and vectorizes.
+    ///
+    /// Sets of flags named by different strong_typedefs are different types,
+    /// so they cannot be combined or compared by mistake.
+    template <typename Flag, std::size_t Size= 64> class flags {
+        static_assert(
+            detail::is_flag_type<Flag>::value,
+            "The flag type must be a strong_typedef with an integral or "
+            "enumeration underlying type");
+        static_assert(Size > 0, "A flags set must have at least one flag");
+
+        static constexpr std::size_t word_bits= 64;
+        static constexpr std::size_t word_count=
+            (Size + word_bits - 1) / word_bits;
+        /// The bits of the last word that are used
+        static constexpr std::uint64_t last_word_mask=
+            Size % word_bits ? (std::uint64_t(1) << Size % word_bits) - 1 :
+                               ~std::uint64_t(0);
+
+    public:
+        using flag_type= Flag;
+
+        /// An empty set
+        constexpr flags() noexcept : words{} {}
+
+        /// A set holding the specified flags
+        constexpr flags(std::initializer_list<Flag> init) noexcept : words{} {
+            for(auto const &flag : init)
+                set(flag);
+        }
+
+        /// The number of flags the set can hold
+        static constexpr std::size_t size() noexcept {
+            return Size;
+        }
+
+        /// Check if flag is in the set
+        constexpr bool test(Flag const &flag) const noexcept {
+            std::size_t const bit= position(flag);
+            return (words[word_index(bit)] >> (bit % word_bits)) & 1;
+        }
+
+        /// Add flag to the set
+        constexpr flags &set(Flag const &flag) noexcept {
+            std::size_t const bit= position(flag);
+            words[word_index(bit)]|= std::uint64_t(1) << (bit % word_bits);
+            return *this;
+        }
+
+        /// Remove flag from the set
+        constexpr flags &reset(Flag const &flag) noexcept {
+            std::size_t const bit= position(flag);
+            words[word_index(bit)]&= ~(std::uint64_t(1) << (bit % word_bits));
+            return *this;
+        }
+
+        /// Add flag to the set if it is not there, and remove it otherwise
+        constexpr flags &flip(Flag const &flag) noexcept {
+            std::size_t const bit= position(flag);
+            words[word_index(bit)]^= std::uint64_t(1) << (bit % word_bits);
+            return *this;
+        }
+
+        /// Add all the flags in other to the set
+        constexpr flags &set(flags const &other) noexcept {
+            return *this|= other;
+        }
+
+        /// Remove all the flags in other from the set
+        constexpr flags &reset(flags const &other) noexcept {
+            for(std::size_t i= 0; i < word_count; ++i)
+                words[i]&= ~other.words[i];
+            return *this;
+        }
+
+        /// Remove all the flags
+        constexpr flags &clear() noexcept {
+            for(std::size_t i= 0; i < word_count; ++i)
+                words[i]= 0;
+            return *this;
+        }
+
+        /// The number of flags in the set
+        constexpr std::size_t count() const noexcept {
+            std::size_t result= 0;
+            for(std::size_t i= 0; i < word_count; ++i)
+                result+= static_cast<std::size_t>(detail::popcount(words[i]));
+            return result;
+        }
+
+        /// Check if the set holds any flags
+        constexpr bool any() const noexcept {
+            std::uint64_t combined= 0;
+            for(std::size_t i= 0; i < word_count; ++i)
+                combined|= words[i];
+            return combined != 0;
+        }
+
+        /// Check if the set is empty
+        constexpr bool none() const noexcept {
+            return !any();
+        }
+
+        /// Check if the set holds every flag in other
+        constexpr bool contains_all(flags const &other) const noexcept {
+            std::uint64_t missing= 0;
+            for(std::size_t i= 0; i < word_count; ++i)
+                missing|= other.words[i] & ~words[i];
+            return missing == 0;
+        }
+
+        /// Check if the set holds at least one flag in other
+        constexpr bool contains_any(flags const &other) const noexcept {
+            std::uint64_t common= 0;
+            for(std::size_t i= 0; i < word_count; ++i)
+                common|= other.words[i] & words[i];
+            return common != 0;
+        }
+
+        /// Call func with each flag in the set, in order of position
+        template <typename Func> constexpr void for_each(Func &&func) const {
+            for(std::size_t i= 0; i < word_count; ++i) {
+                for(std::uint64_t remaining= words[i]; remaining;
+                    remaining&= remaining - 1) {
+                    std::size_t const bit= i * word_bits +
+                                           static_cast<std::size_t>(
+                                               detail::countr_zero(remaining));
+                    func(Flag(static_cast<
+                              typename Flag::underlying_value_type>(bit)));
+                }
+            }
+        }
+
+        /// The word of the set holding the bits for flags index*64 to
+        /// index*64+63, with the flag at the lowest position in the lowest
+        /// bit
+        constexpr std::uint64_t word(std::size_t index) const noexcept {
+            assert(index < word_count);
+            return words[index];
+        }
+
+        constexpr flags &operator|=(flags const &other) noexcept {
+            for(std::size_t i= 0; i < word_count; ++i)
+                words[i]|= other.words[i];
+            return *this;
+        }
+        constexpr flags &operator&=(flags const &other) noexcept {
+            for(std::size_t i= 0; i < word_count; ++i)
+                words[i]&= other.words[i];
+            return *this;
+        }
+        constexpr flags &operator^=(flags const &other) noexcept {
+            for(std::size_t i= 0; i < word_count; ++i)
+                words[i]^= other.words[i];
+            return *this;
+        }
+
+        friend constexpr flags
+        operator|(flags lhs, flags const &rhs) noexcept {
+            return lhs|= rhs;
+        }
+        friend constexpr flags
+        operator&(flags lhs, flags const &rhs) noexcept {
+            return lhs&= rhs;
+        }
+        friend constexpr flags
+        operator^(flags lhs, flags const &rhs) noexcept {
+            return lhs^= rhs;
+        }
+
+        /// The flags that are in lhs but not in rhs
+        friend constexpr flags and_not(flags lhs, flags const &rhs) noexcept {
+            return lhs.reset(rhs);
+        }
+
+        /// The set of all the flags that are not in this set
+        constexpr flags operator~() const noexcept {
+            flags result;
+            for(std::size_t i= 0; i < word_count; ++i)
+                result.words[i]= ~words[i];
+            result.words[word_count - 1]&= last_word_mask;
+            return result;
+        }
+
+        friend constexpr bool
+        operator==(flags const &lhs, flags const &rhs) noexcept {
+            std::uint64_t difference= 0;
+            for(std::size_t i= 0; i < word_count; ++i)
+                difference|= lhs.words[i] ^ rhs.words[i];
+            return difference == 0;
+        }
+        friend constexpr bool
+        operator!=(flags const &lhs, flags const &rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        /// The index of the word holding bit. With a single word this is a
+        /// constant, so the compiler does not have to compute it.
+        static constexpr std::size_t word_index(std::size_t bit) noexcept {
+            return word_count == 1 ? 0 : bit / word_bits;
+        }
+
+        static constexpr std::size_t position(Flag const &flag) noexcept {
+            std::size_t const bit=
+                static_cast<std::size_t>(flag.underlying_value());
+            assert(bit < Size);
+            return bit;
+        }
+
+        std::uint64_t words[word_count];
+    };
+} // namespace jss
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef JSS_STRONG_TYPEDEF_FORMAT_HPP
+#define JSS_STRONG_TYPEDEF_FORMAT_HPP
+#include "strong_typedef.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#ifndef __cpp_lib_to_chars
+#include <cstdio>
+#include <limits>
+#endif
+
+#if __cplusplus > 201703L && defined(__has_include)
+#if __has_include(<format>)
+#include <format>
+#endif
+#endif
+
+namespace jss {
+    /// The units used when formatting a strong_typedef with the formattable
+    /// property: no prefix or suffix. To add units, derive from this and
+    /// hide prefix or suffix, e.g.
+    ///
+    /// struct milliseconds_units : jss::format_units {
+    ///     static constexpr std::string_view suffix= "ms";
+    /// };
+    ///
+    /// and use the property formattable_with<milliseconds_units>.
+    struct format_units {
+        /// Text written before the value
+        static constexpr std::string_view prefix{};
+        /// Text written after the value
+        static constexpr std::string_view suffix{};
+    };
+
+    namespace strong_typedef_properties {
+        /// Allow this strong_typedef to be formatted with jss::to_chars, and
+        /// with std::format where it is available, writing Units::prefix,
+        /// then the underlying value, then Units::suffix. Formatting does not
+        /// depend on the locale, and does not use iostreams.
+        template <typename Units> struct formattable_with {
+            template <typename Derived, typename ValueType> struct mixin {
+                using format_units_type= Units;
+            };
+        };
+
+        /// Allow this strong_typedef to be formatted with jss::to_chars, and
+        /// with std::format where it is available, without units
+        struct formattable : formattable_with<format_units> {};
+    } // namespace strong_typedef_properties
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if T is a strong_typedef with the formattable or
+        /// formattable_with property
+        template <typename T, typename= void>
+        struct is_formattable : std::false_type {};
+
+        template <typename T>
+        struct is_formattable<
+            T, std::void_t<
+                   typename T::underlying_value_type,
+                   typename T::format_units_type>>
+            : std::is_base_of<
+                  typename strong_typedef_properties::formattable_with<
+                      typename T::format_units_type>::
+                      template mixin<T, typename T::underlying_value_type>,
+                  T> {};
+
+        /// Copy text to [first,last), returning the end of the copied text,
+        /// or null if there is not enough space
+        inline char *
+        copy_text(char *first, char *last, std::string_view text) noexcept {
+            if(static_cast<std::size_t>(last - first) < text.size())
+                return nullptr;
+            return std::copy(text.begin(), text.end(), first);
+        }
+
+        /// Write value to [first,last). Numbers are written with
+        /// std::to_chars, so the result does not depend on the locale, and
+        /// floating point values use the shortest representation that
+        /// reads back as the same value. Types convertible to
+        /// std::string_view are copied.
+        template <typename T>
+        std::to_chars_result
+        value_to_chars(char *first, char *last, T const &value) noexcept {
+            if constexpr(
+                std::is_integral<T>::value && !std::is_same<T, bool>::value) {
+                return std::to_chars(first, last, value);
+            } else if constexpr(std::is_floating_point<T>::value) {
+#ifdef __cpp_lib_to_chars
+                return std::to_chars(first, last, value);
+#else
+                int const size= std::snprintf(
+                    first, static_cast<std::size_t>(last - first), "%.*g",
+                    std::numeric_limits<T>::max_digits10,
+                    static_cast<double>(value));
+                if(size < 0 || size >= last - first)
+                    return {last, std::errc::value_too_large};
+                return {first + size, std::errc()};
+#endif
+            } else {
+                static_assert(
+                    std::is_convertible<T const &, std::string_view>::value,
+                    "The value type must be a number, or convertible to "
+                    "std::string_view");
+                char *const end= copy_text(first, last, value);
+                if(!end)
+                    return {last, std::errc::value_too_large};
+                return {end, std::errc()};
+            }
+        }
+    } // namespace detail
+
+    /// Write value to the buffer [first,last) as the prefix of its units,
+    /// the underlying value and the suffix of its units, without using the
+    /// locale or iostreams. On success, returns a pointer to the end of the
+    /// text written and std::errc(). If the buffer is too small, returns
+    /// last and std::errc::value_too_large, and the contents of the buffer
+    /// are unspecified.
+    template <
+        typename StrongTypedef,
+        typename=
+            std::enable_if_t<detail::is_formattable<StrongTypedef>::value>>
+    std::to_chars_result
+    to_chars(char *first, char *last, StrongTypedef const &value) noexcept {
+        using units= typename StrongTypedef::format_units_type;
+        first= detail::copy_text(first, last, units::prefix);
+        if(!first)
+            return {last, std::errc::value_too_large};
+        auto const result=
+            detail::value_to_chars(first, last, value.underlying_value());
+        if(result.ec != std::errc())
+            return result;
+        char *const end= detail::copy_text(result.ptr, last, units::suffix);
+        if(!end)
+            return {last, std::errc::value_too_large};
+        return {end, std::errc()};
+    }
+} // namespace jss
+
+#ifdef __cpp_lib_format
+namespace std {
+    /// A specialization of std::formatter for those instances of
+    /// strong_typedef that have the formattable or formattable_with
+    /// property. The format specification is that of the underlying value,
+    /// and the prefix and suffix of the units are written around it.
+    template <typename Tag, typename ValueType, typename... Properties>
+        requires jss::detail::is_formattable<
+            jss::strong_typedef<Tag, ValueType, Properties...>>::value
+    struct formatter<jss::strong_typedef<Tag, ValueType, Properties...>, char>
+        : formatter<ValueType, char> {
+        template <typename FormatContext>
+        auto format(
+            jss::strong_typedef<Tag, ValueType, Properties...> const &value,
+            FormatContext &ctx) const {
+            using units= typename jss::strong_typedef<
+                Tag, ValueType, Properties...>::format_units_type;
+            ctx.advance_to(std::copy(
+                units::prefix.begin(), units::prefix.end(), ctx.out()));
+            auto out= formatter<ValueType, char>::format(
+                value.underlying_value(), ctx);
+            return std::copy(units::suffix.begin(), units::suffix.end(), out);
+        }
+    };
+} // namespace std
+#endif
+
+#endif
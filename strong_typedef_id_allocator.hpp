@@ -0,0 +1,341 @@
+#ifndef JSS_STRONG_TYPEDEF_ID_ALLOCATOR_HPP
+#define JSS_STRONG_TYPEDEF_ID_ALLOCATOR_HPP
+#include "strong_typedef.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jss {
+    /// A thread-safe, lock-free allocator of strong_typedef IDs. Id must be
+    /// a strong_typedef with an unsigned integral underlying type.
+    /// Allocating and releasing IDs take constant time. Released IDs are
+    /// held in batches of up to BlockSize IDs on a lock-free stack, whose
+    /// head is tagged to avoid the ABA problem, and the batches are reused,
+    /// so memory is only allocated when the pool of batches grows.
+    ///
+    /// Fresh IDs are handed out in sequence from a single atomic counter.
+    /// To avoid every thread contending on that counter, each thread should
+    /// allocate through its own id_allocator::cache, which reserves
+    /// BlockSize IDs at a time and keeps the IDs its thread releases.
+    ///
+    /// Released IDs are recycled. If GenerationBits is non-zero, the top
+    /// GenerationBits bits of the underlying value hold a generation count,
+    /// which is incremented each time an ID is recycled, so a stale copy of
+    /// a released ID compares unequal to the ID that reuses its index. The
+    /// remaining bits hold the index. Generations wrap around, so a stale ID
+    /// could only match again after 2^GenerationBits reuses of the index.
+    template <
+        typename Id, unsigned GenerationBits= 0, std::size_t BlockSize= 64>
+    class id_allocator {
+        using value_type= typename Id::underlying_value_type;
+
+        static_assert(
+            std::is_integral<value_type>::value &&
+                std::is_unsigned<value_type>::value,
+            "The Id type must be a strong_typedef with an unsigned integral "
+            "underlying type");
+        static_assert(
+            GenerationBits < std::numeric_limits<value_type>::digits,
+            "There must be at least one bit for the index");
+        static_assert(BlockSize > 0, "The block size must be at least one");
+        static_assert(
+            std::atomic<value_type>::is_always_lock_free,
+            "Allocating IDs must be lock-free");
+
+        /// A batch of up to BlockSize released IDs. Batches are kept in a
+        /// pool owned by the allocator, and identified by their index in the
+        /// pool, so they are never freed while the allocator exists. Batches
+        /// holding IDs are on the free list, and empty batches are on the
+        /// spare list.
+        struct batch {
+            std::atomic<std::uint32_t> next;
+            std::size_t count;
+            value_type ids[BlockSize];
+        };
+
+    public:
+        using id_type= Id;
+
+        /// The number of bits used for the index
+        static constexpr unsigned index_bits=
+            std::numeric_limits<value_type>::digits - GenerationBits;
+        /// The number of bits used for the generation
+        static constexpr unsigned generation_bits= GenerationBits;
+        /// The number of IDs reserved by a cache at a time
+        static constexpr std::size_t block_size= BlockSize;
+
+        /// All allocated indexes are less than index_limit
+        static constexpr value_type index_limit=
+            static_cast<value_type>(~value_type(0)) >> GenerationBits;
+
+        /// An allocator that starts allocating at first_index
+        explicit id_allocator(value_type first_index= 0) noexcept :
+            next_index(first_index), free_list(empty_list),
+            spare_list(empty_list), batch_count(0), segments{} {}
+
+        id_allocator(id_allocator const &)= delete;
+        id_allocator &operator=(id_allocator const &)= delete;
+
+        ~id_allocator() {
+            for(auto &segment : segments)
+                delete[] segment.load(std::memory_order_relaxed);
+        }
+
+        /// The index part of id
+        static constexpr value_type index_of(Id const &id) noexcept {
+            return id.underlying_value() & index_limit;
+        }
+
+        /// The generation part of id
+        static constexpr value_type generation_of(Id const &id) noexcept {
+            if constexpr(GenerationBits == 0) {
+                return 0;
+            } else {
+                return id.underlying_value() >> index_bits;
+            }
+        }
+
+        /// Allocate an ID directly from the shared state. Threads that
+        /// allocate many IDs should use a cache instead.
+        Id allocate() {
+            std::uint32_t const recycled= pop(free_list);
+            if(recycled != no_batch) {
+                batch &source= get_batch(recycled);
+                Id const id(source.ids[--source.count]);
+                push(source.count ? free_list : spare_list, recycled);
+                return id;
+            }
+            value_type const first= reserve(1).first;
+            return Id(first);
+        }
+
+        /// Release id so that its index can be reused. The ID must have been
+        /// allocated from this allocator, and not already released. The ID
+        /// is added to the batch at the head of the free list if it has
+        /// room, and otherwise to a batch from the pool of spare batches, so
+        /// this takes constant time, and only allocates memory when the
+        /// pool has to grow.
+        void release(Id const &id) {
+            value_type const released= next_generation(id).underlying_value();
+            std::uint32_t const head= pop(free_list);
+            if(head != no_batch) {
+                batch &target= get_batch(head);
+                bool const added= target.count < BlockSize;
+                if(added)
+                    target.ids[target.count++]= released;
+                push(free_list, head);
+                if(added)
+                    return;
+            }
+            publish(&released, 1);
+        }
+
+        /// A per-thread cache of IDs. Each cache must only be used by one
+        /// thread at a time, and must be destroyed before the allocator.
+        /// When the cache is destroyed, its unused IDs are returned to the
+        /// allocator.
+        class cache {
+        public:
+            explicit cache(id_allocator &owner_) :
+                owner(owner_), next(0), block_end(0) {
+                free_ids.reserve(2 * BlockSize);
+            }
+
+            cache(cache const &)= delete;
+            cache &operator=(cache const &)= delete;
+
+            ~cache() {
+                while(next != block_end)
+                    free_ids.push_back(next++);
+                for(std::size_t i= 0; i < free_ids.size(); i+= BlockSize)
+                    owner.publish(
+                        free_ids.data() + i,
+                        std::min(BlockSize, free_ids.size() - i));
+            }
+
+            /// Allocate an ID, preferring IDs released through this cache,
+            /// then fresh IDs from the current block, then IDs released to
+            /// the allocator, and finally a new block of fresh IDs
+            Id allocate() {
+                if(free_ids.empty() && next == block_end) {
+                    std::uint32_t const recycled= owner.pop(owner.free_list);
+                    if(recycled != no_batch) {
+                        batch &source= owner.get_batch(recycled);
+                        free_ids.assign(
+                            source.ids, source.ids + source.count);
+                        owner.push(owner.spare_list, recycled);
+                    }
+                }
+                if(!free_ids.empty()) {
+                    Id const id(free_ids.back());
+                    free_ids.pop_back();
+                    return id;
+                }
+                if(next == block_end)
+                    std::tie(next, block_end)= owner.reserve(BlockSize);
+                return Id(next++);
+            }
+
+            /// Release id so that its index can be reused. If this cache
+            /// holds two blocks of released IDs, one block is passed back
+            /// to the allocator for use by other threads.
+            void release(Id const &id) {
+                free_ids.push_back(next_generation(id).underlying_value());
+                if(free_ids.size() >= 2 * BlockSize) {
+                    owner.publish(
+                        free_ids.data() + free_ids.size() - BlockSize,
+                        BlockSize);
+                    free_ids.resize(free_ids.size() - BlockSize);
+                }
+            }
+
+        private:
+            id_allocator &owner;
+            std::vector<value_type> free_ids;
+            value_type next;
+            value_type block_end;
+        };
+
+    private:
+        /// The ID with the same index as id, and the next generation
+        static Id next_generation(Id const &id) noexcept {
+            if constexpr(GenerationBits == 0) {
+                return id;
+            } else {
+                return Id(static_cast<value_type>(
+                    id.underlying_value() + (value_type(1) << index_bits)));
+            }
+        }
+
+        /// Reserve up to count fresh indexes, and return the first and one
+        /// past the last. Fewer than count are reserved if fewer remain.
+        /// Throws std::length_error if the indexes are exhausted.
+        std::pair<value_type, value_type> reserve(std::size_t count) {
+            value_type first= next_index.load(std::memory_order_relaxed);
+            value_type last;
+            do {
+                if(first >= index_limit)
+                    throw std::length_error("jss::id_allocator: out of IDs");
+                last= static_cast<std::size_t>(index_limit - first) < count ?
+                          index_limit :
+                          static_cast<value_type>(first + count);
+            } while(!next_index.compare_exchange_weak(
+                first, last, std::memory_order_relaxed));
+            return {first, last};
+        }
+
+        /// The list heads pack the index of the first batch with a tag that
+        /// is changed by every push, so a pop that read a stale head fails
+        /// its compare-exchange instead of corrupting the list
+        static constexpr std::uint32_t no_batch= ~std::uint32_t(0);
+        static constexpr std::uint64_t empty_list= no_batch;
+
+        /// The first segment of the pool holds first_segment_size batches,
+        /// and each later segment holds as many as all the segments before
+        /// it, so batches never move
+        static constexpr unsigned first_segment_bits= 4;
+        static constexpr std::uint32_t first_segment_size=
+            std::uint32_t(1) << first_segment_bits;
+        static constexpr unsigned segment_count= 33 - first_segment_bits;
+
+        static unsigned segment_index(std::uint32_t index) noexcept {
+            return index < first_segment_size ?
+                       0 :
+                       detail::bit_width(index) - first_segment_bits;
+        }
+
+        static std::uint32_t segment_start(unsigned segment) noexcept {
+            return segment ? first_segment_size << (segment - 1) : 0;
+        }
+
+        batch &get_batch(std::uint32_t index) const noexcept {
+            unsigned const segment= segment_index(index);
+            return segments[segment].load(std::memory_order_acquire)
+                [index - segment_start(segment)];
+        }
+
+        /// Push the batch with the specified index onto list
+        void
+        push(std::atomic<std::uint64_t> &list, std::uint32_t index) noexcept {
+            batch &pushed= get_batch(index);
+            std::uint64_t head= list.load(std::memory_order_relaxed);
+            std::uint64_t new_head;
+            do {
+                pushed.next.store(
+                    static_cast<std::uint32_t>(head),
+                    std::memory_order_relaxed);
+                new_head= (((head >> 32) + 1) << 32) | index;
+            } while(!list.compare_exchange_weak(
+                head, new_head, std::memory_order_release,
+                std::memory_order_relaxed));
+        }
+
+        /// Pop a batch from list, and return its index, or no_batch if the
+        /// list is empty. Batches are never freed, so reading the next
+        /// index of a batch that another thread has just popped is safe,
+        /// and the tag makes the compare-exchange fail in that case.
+        std::uint32_t pop(std::atomic<std::uint64_t> &list) noexcept {
+            std::uint64_t head= list.load(std::memory_order_acquire);
+            std::uint64_t new_head;
+            do {
+                std::uint32_t const index= static_cast<std::uint32_t>(head);
+                if(index == no_batch)
+                    return no_batch;
+                std::uint32_t const next=
+                    get_batch(index).next.load(std::memory_order_relaxed);
+                new_head= (head & ~std::uint64_t(no_batch)) | next;
+            } while(!list.compare_exchange_weak(
+                head, new_head, std::memory_order_acquire,
+                std::memory_order_acquire));
+            return static_cast<std::uint32_t>(head);
+        }
+
+        /// Put count released IDs, which must be at most BlockSize, on the
+        /// free list in a single batch
+        void publish(value_type const *ids, std::size_t count) {
+            std::uint32_t const index= take_spare_batch();
+            batch &target= get_batch(index);
+            std::copy(ids, ids + count, target.ids);
+            target.count= count;
+            push(free_list, index);
+        }
+
+        /// An empty batch from the spare list, or a new batch from the pool
+        std::uint32_t take_spare_batch() {
+            std::uint32_t const spare= pop(spare_list);
+            if(spare != no_batch)
+                return spare;
+            std::uint32_t const index=
+                batch_count.fetch_add(1, std::memory_order_relaxed);
+            if(index == no_batch)
+                throw std::length_error("jss::id_allocator: too many batches");
+            unsigned const segment= segment_index(index);
+            if(!segments[segment].load(std::memory_order_acquire)) {
+                std::uint32_t const size=
+                    segment ? segment_start(segment) : first_segment_size;
+                batch *const fresh= new batch[size];
+                batch *expected= nullptr;
+                if(!segments[segment].compare_exchange_strong(
+                       expected, fresh, std::memory_order_acq_rel))
+                    delete[] fresh;
+            }
+            return index;
+        }
+
+        std::atomic<value_type> next_index;
+        std::atomic<std::uint64_t> free_list;
+        std::atomic<std::uint64_t> spare_list;
+        std::atomic<std::uint32_t> batch_count;
+        std::atomic<batch *> segments[segment_count];
+    };
+} // namespace jss
+
+#endif
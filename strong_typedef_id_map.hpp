@@ -0,0 +1,387 @@
+#ifndef JSS_STRONG_TYPEDEF_ID_MAP_HPP
+#define JSS_STRONG_TYPEDEF_ID_MAP_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check that Id can be used as the key of an id_map: it must be a
+        /// strong_typedef with an integral underlying type
+        template <typename Id, typename= void>
+        struct is_id_type : std::false_type {};
+
+        template <typename Id>
+        struct is_id_type<Id, std::void_t<typename Id::underlying_value_type>>
+            : std::is_integral<typename Id::underlying_value_type> {};
+    } // namespace detail
+
+    /// An associative container from a strong_typedef Id to T, for IDs that
+    /// come from a small or mostly-contiguous range, such as those handed
+    /// out by a sequential allocator. Lookup indexes directly by the value
+    /// of the ID, so there is no hashing, and no per-element allocation.
+    ///
+    /// This is a sparse set: the IDs and values are stored in two dense
+    /// arrays, in insertion order, and a paged sparse array maps each ID to
+    /// its position in the dense arrays. A page of the sparse array is only
+    /// allocated when an ID in its range is inserted. The first
+    /// direct_page_limit pages are found by indexing a page directory,
+    /// which grows to cover the largest of these pages in use. Pages beyond
+    /// that, such as those for IDs with generation counts in their high
+    /// bits, are found in a hash table, so a few large IDs do not require
+    /// memory for all the smaller ones. Iteration visits the dense arrays in
+    /// order. erase moves the last element into the place of the erased
+    /// one, so it changes the iteration order.
+    ///
+    /// Id must be a strong_typedef with an integral underlying type.
+    /// Inserting a negative ID throws std::out_of_range, and looking one up
+    /// finds nothing. Each page of the sparse array covers 2^PageBits IDs.
+    template <typename Id, typename T, std::size_t PageBits= 12> class id_map {
+        static_assert(
+            detail::is_id_type<Id>::value,
+            "The Id type must be a strong_typedef with an integral "
+            "underlying type");
+        static_assert(
+            PageBits > 0 && PageBits < std::numeric_limits<std::size_t>::digits,
+            "PageBits must be a valid shift");
+
+    public:
+        using key_type= Id;
+        using mapped_type= T;
+        using size_type= std::size_t;
+
+        /// The number of IDs covered by each page of the sparse array
+        static constexpr size_type page_size= size_type(1) << PageBits;
+        /// The number of pages that are found by direct indexing. The page
+        /// directory holds at most this many pointers.
+        static constexpr size_type direct_page_limit= 4096;
+
+        /// An iterator over the elements in dense order. Dereferencing it
+        /// gives a std::pair of a reference to the ID and a reference to the
+        /// value, which can be used with structured bindings.
+        template <bool Const> class basic_iterator {
+            using map_type= std::conditional_t<Const, id_map const, id_map>;
+            using mapped_reference= std::conditional_t<Const, T const &, T &>;
+
+        public:
+            using iterator_category= std::forward_iterator_tag;
+            using value_type= std::pair<Id const &, mapped_reference>;
+            using difference_type= std::ptrdiff_t;
+            using reference= value_type;
+            using pointer= void;
+
+            basic_iterator()= default;
+
+            /// A non-const iterator can be converted to a const iterator
+            template <
+                bool OtherConst,
+                typename= std::enable_if_t<Const && !OtherConst>>
+            basic_iterator(basic_iterator<OtherConst> const &other) noexcept :
+                map(other.map), position(other.position) {}
+
+            reference operator*() const noexcept {
+                return reference(
+                    map->dense_ids[position], map->dense_values[position]);
+            }
+
+            basic_iterator &operator++() noexcept {
+                ++position;
+                return *this;
+            }
+            basic_iterator operator++(int) noexcept {
+                basic_iterator temp(*this);
+                ++position;
+                return temp;
+            }
+
+            friend bool operator==(
+                basic_iterator const &lhs, basic_iterator const &rhs) noexcept {
+                return lhs.position == rhs.position;
+            }
+            friend bool operator!=(
+                basic_iterator const &lhs, basic_iterator const &rhs) noexcept {
+                return lhs.position != rhs.position;
+            }
+
+        private:
+            friend class id_map;
+            template <bool> friend class basic_iterator;
+
+            basic_iterator(map_type *map_, size_type position_) noexcept :
+                map(map_), position(position_) {}
+
+            map_type *map= nullptr;
+            size_type position= 0;
+        };
+
+        using iterator= basic_iterator<false>;
+        using const_iterator= basic_iterator<true>;
+
+        id_map()= default;
+
+        id_map(id_map &&)= default;
+        id_map &operator=(id_map &&)= default;
+
+        id_map(id_map const &other) :
+            pages(copy_pages(other.pages)),
+            far_pages(copy_pages(other.far_pages)), dense_ids(other.dense_ids),
+            dense_values(other.dense_values) {}
+
+        id_map &operator=(id_map const &other) {
+            id_map temp(other);
+            swap(temp);
+            return *this;
+        }
+
+        /// Find the value for id. Returns nullptr if there is no element
+        /// with that ID.
+        T *find(Id const &id) noexcept {
+            size_type const pos= lookup(id);
+            return pos == npos ? nullptr : &dense_values[pos];
+        }
+        T const *find(Id const &id) const noexcept {
+            size_type const pos= lookup(id);
+            return pos == npos ? nullptr : &dense_values[pos];
+        }
+
+        bool contains(Id const &id) const noexcept {
+            return lookup(id) != npos;
+        }
+
+        /// Checked access to the value for id, which throws
+        /// std::out_of_range if there is no element with that ID
+        T &at(Id const &id) {
+            if(T *value= find(id))
+                return *value;
+            throw std::out_of_range("jss::id_map::at: no such ID");
+        }
+        T const &at(Id const &id) const {
+            if(T const *value= find(id))
+                return *value;
+            throw std::out_of_range("jss::id_map::at: no such ID");
+        }
+
+        /// The value for id, which is value-initialized first if there is no
+        /// element with that ID
+        T &operator[](Id const &id) {
+            return *try_emplace(id).first;
+        }
+
+        /// Construct a value for id from args if there is no element with
+        /// that ID. Returns a pointer to the value for id, and true if it was
+        /// inserted.
+        template <typename... Args>
+        std::pair<T *, bool> try_emplace(Id const &id, Args &&... args) {
+            size_type &slot= sparse_slot(id);
+            if(slot != npos)
+                return {&dense_values[slot], false};
+            dense_values.emplace_back(std::forward<Args>(args)...);
+            try {
+                dense_ids.push_back(id);
+            } catch(...) {
+                dense_values.pop_back();
+                throw;
+            }
+            slot= dense_values.size() - 1;
+            return {&dense_values.back(), true};
+        }
+
+        /// Insert value for id, or assign it to the existing value. Returns
+        /// a pointer to the value for id, and true if it was inserted.
+        template <typename U>
+        std::pair<T *, bool> insert_or_assign(Id const &id, U &&value) {
+            auto result= try_emplace(id, std::forward<U>(value));
+            if(!result.second)
+                *result.first= std::forward<U>(value);
+            return result;
+        }
+
+        /// Remove the element with id, if there is one, by moving the last
+        /// element into its place. Returns the number of elements removed.
+        size_type erase(Id const &id) {
+            size_type const pos= lookup(id);
+            if(pos == npos)
+                return 0;
+            size_type const last= dense_values.size() - 1;
+            if(pos != last) {
+                dense_values[pos]= std::move(dense_values[last]);
+                dense_ids[pos]= std::move(dense_ids[last]);
+                existing_slot(dense_ids[pos])= pos;
+            }
+            existing_slot(id)= npos;
+            dense_values.pop_back();
+            dense_ids.pop_back();
+            return 1;
+        }
+
+        /// Remove all the elements. The pages of the sparse array are kept.
+        void clear() noexcept {
+            for(auto const &id : dense_ids)
+                existing_slot(id)= npos;
+            dense_ids.clear();
+            dense_values.clear();
+        }
+
+        /// Reserve space in the dense arrays for count elements
+        void reserve(size_type count) {
+            dense_ids.reserve(count);
+            dense_values.reserve(count);
+        }
+
+        size_type size() const noexcept {
+            return dense_values.size();
+        }
+        bool empty() const noexcept {
+            return dense_values.empty();
+        }
+
+        /// The IDs of the elements, in dense order
+        span<Id const> ids() const noexcept {
+            return span<Id const>(dense_ids.data(), dense_ids.size());
+        }
+
+        /// The values of the elements, in dense order. values()[i] is the
+        /// value for ids()[i].
+        span<T> values() noexcept {
+            return span<T>(dense_values.data(), dense_values.size());
+        }
+        span<T const> values() const noexcept {
+            return span<T const>(dense_values.data(), dense_values.size());
+        }
+
+        iterator begin() noexcept {
+            return iterator(this, 0);
+        }
+        const_iterator begin() const noexcept {
+            return const_iterator(this, 0);
+        }
+        iterator end() noexcept {
+            return iterator(this, size());
+        }
+        const_iterator end() const noexcept {
+            return const_iterator(this, size());
+        }
+
+        void swap(id_map &other) noexcept {
+            pages.swap(other.pages);
+            far_pages.swap(other.far_pages);
+            dense_ids.swap(other.dense_ids);
+            dense_values.swap(other.dense_values);
+        }
+        friend void swap(id_map &lhs, id_map &rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+    private:
+        static constexpr size_type npos= static_cast<size_type>(-1);
+
+        using page_pointer= std::unique_ptr<size_type[]>;
+
+        static bool is_negative(Id const &id) noexcept {
+            if constexpr(std::is_signed<
+                             typename Id::underlying_value_type>::value) {
+                return id.underlying_value() < 0;
+            } else {
+                return false;
+            }
+        }
+
+        static size_type to_key(Id const &id) noexcept {
+            return static_cast<size_type>(id.underlying_value());
+        }
+
+        /// The page with the specified number, or null if it has not been
+        /// allocated
+        size_type *find_page(size_type page) const noexcept {
+            if(page < pages.size())
+                return pages[page].get();
+            if(page < direct_page_limit || far_pages.empty())
+                return nullptr;
+            auto const found= far_pages.find(page);
+            return found == far_pages.end() ? nullptr : found->second.get();
+        }
+
+        /// The position of id in the dense arrays, or npos
+        size_type lookup(Id const &id) const noexcept {
+            if(is_negative(id))
+                return npos;
+            size_type const key= to_key(id);
+            size_type const *const page= find_page(key >> PageBits);
+            return page ? page[key & (page_size - 1)] : npos;
+        }
+
+        /// The entry for id in the sparse array, where id is in the map
+        size_type &existing_slot(Id const &id) noexcept {
+            size_type const key= to_key(id);
+            return find_page(key >> PageBits)[key & (page_size - 1)];
+        }
+
+        /// The entry for id in the sparse array, allocating its page if
+        /// necessary
+        size_type &sparse_slot(Id const &id) {
+            if(is_negative(id))
+                throw std::out_of_range("jss::id_map: negative ID");
+            size_type const key= to_key(id);
+            size_type const page= key >> PageBits;
+            page_pointer &entry= page < direct_page_limit ?
+                                     direct_entry(page) :
+                                     far_pages[page];
+            if(!entry) {
+                entry.reset(new size_type[page_size]);
+                std::fill_n(entry.get(), page_size, npos);
+            }
+            return entry[key & (page_size - 1)];
+        }
+
+        /// The entry in the page directory for page, which must be less
+        /// than direct_page_limit
+        page_pointer &direct_entry(size_type page) {
+            if(page >= pages.size())
+                pages.resize(page + 1);
+            return pages[page];
+        }
+
+        static std::vector<page_pointer>
+        copy_pages(std::vector<page_pointer> const &source) {
+            std::vector<page_pointer> result(source.size());
+            for(size_type i= 0; i < source.size(); ++i) {
+                if(source[i])
+                    result[i]= copy_page(source[i]);
+            }
+            return result;
+        }
+
+        static std::unordered_map<size_type, page_pointer> copy_pages(
+            std::unordered_map<size_type, page_pointer> const &source) {
+            std::unordered_map<size_type, page_pointer> result;
+            for(auto const &entry : source)
+                result.emplace(entry.first, copy_page(entry.second));
+            return result;
+        }
+
+        static page_pointer copy_page(page_pointer const &source) {
+            page_pointer result(new size_type[page_size]);
+            std::copy_n(source.get(), page_size, result.get());
+            return result;
+        }
+
+        /// The page directory for the first direct_page_limit pages
+        std::vector<page_pointer> pages;
+        /// The pages beyond direct_page_limit, by page number
+        std::unordered_map<size_type, page_pointer> far_pages;
+        std::vector<Id> dense_ids;
+        std::vector<T> dense_values;
+    };
+} // namespace jss
+
+#endif
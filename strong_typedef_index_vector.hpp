@@ -0,0 +1,367 @@
+#ifndef JSS_STRONG_TYPEDEF_INDEX_VECTOR_HPP
+#define JSS_STRONG_TYPEDEF_INDEX_VECTOR_HPP
+#include "strong_typedef.hpp"
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check that Index can be used to index an index_vector: it must be
+        /// a strong_typedef with an integral underlying type that is
+        /// pre-incrementable and ordered
+        template <typename Index, typename= void>
+        struct is_index_type : std::false_type {};
+
+        template <typename Index>
+        struct is_index_type<
+            Index, std::void_t<
+                       typename Index::underlying_value_type,
+                       decltype(++std::declval<Index &>()),
+                       decltype(
+                           std::declval<Index const &>() <
+                           std::declval<Index const &>())>>
+            : std::is_integral<typename Index::underlying_value_type> {};
+
+        /// Convert an index to a position in the underlying storage
+        template <typename Index>
+        constexpr std::size_t to_position(Index const &index) noexcept {
+            return static_cast<std::size_t>(index.underlying_value());
+        }
+
+        /// Convert a position in the underlying storage to an index
+        template <typename Index>
+        constexpr Index to_index(std::size_t position) noexcept {
+            return Index(
+                static_cast<typename Index::underlying_value_type>(position));
+        }
+    } // namespace detail
+
+    /// A half-open range of consecutive strong_typedef index values,
+    /// [first,last). Iterating over the range yields Index values, and uses
+    /// the pre-increment operator of Index, so Index must be
+    /// pre_incrementable.
+    template <typename Index> class index_range {
+    public:
+        class iterator {
+        public:
+            using iterator_category= std::forward_iterator_tag;
+            using value_type= Index;
+            using difference_type= std::ptrdiff_t;
+            using pointer= Index const *;
+            using reference= Index const &;
+
+            iterator()= default;
+
+            explicit constexpr iterator(Index current_) noexcept(
+                std::is_nothrow_copy_constructible<Index>::value) :
+                current(current_) {}
+
+            constexpr reference operator*() const noexcept {
+                return current;
+            }
+            constexpr pointer operator->() const noexcept {
+                return &current;
+            }
+
+            iterator &operator++() {
+                ++current;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp(*this);
+                ++current;
+                return temp;
+            }
+
+            friend constexpr bool
+            operator==(iterator const &lhs, iterator const &rhs) noexcept {
+                return lhs.current.underlying_value() ==
+                       rhs.current.underlying_value();
+            }
+            friend constexpr bool
+            operator!=(iterator const &lhs, iterator const &rhs) noexcept {
+                return !(lhs == rhs);
+            }
+
+        private:
+            Index current;
+        };
+
+        /// The range [first_,last_)
+        constexpr index_range(Index first_, Index last_) noexcept(
+            std::is_nothrow_copy_constructible<Index>::value) :
+            first(first_),
+            last(last_) {}
+
+        constexpr iterator begin() const {
+            return iterator(first);
+        }
+        constexpr iterator end() const {
+            return iterator(last);
+        }
+
+        /// The number of indexes in the range
+        constexpr std::size_t size() const noexcept {
+            return detail::to_position(last) - detail::to_position(first);
+        }
+        constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+    private:
+        Index first;
+        Index last;
+    };
+
+    /// A sequence container like std::vector, where the elements can only be
+    /// accessed by a strong_typedef index type, so a value of one index type
+    /// cannot accidentally be used to access the elements of a container
+    /// indexed by another index type. Index must be a strong_typedef with an
+    /// integral underlying type that is ordered and pre_incrementable.
+    ///
+    /// operator[] only checks the index with assert, so release builds
+    /// (with NDEBUG defined) have no bounds checks, exactly as for
+    /// std::vector. at() always checks, and throws std::out_of_range.
+    template <typename Index, typename T, typename Allocator= std::allocator<T>>
+    class index_vector {
+        static_assert(
+            detail::is_index_type<Index>::value,
+            "The index type must be an ordered, incrementable strong_typedef "
+            "with an integral underlying type");
+
+        using storage_type= std::vector<T, Allocator>;
+
+    public:
+        using index_type= Index;
+        using value_type= T;
+        using allocator_type= Allocator;
+        using size_type= typename storage_type::size_type;
+        using difference_type= typename storage_type::difference_type;
+        using reference= typename storage_type::reference;
+        using const_reference= typename storage_type::const_reference;
+        using pointer= typename storage_type::pointer;
+        using const_pointer= typename storage_type::const_pointer;
+        using iterator= typename storage_type::iterator;
+        using const_iterator= typename storage_type::const_iterator;
+        using reverse_iterator= typename storage_type::reverse_iterator;
+        using const_reverse_iterator=
+            typename storage_type::const_reverse_iterator;
+
+        index_vector()= default;
+
+        explicit index_vector(Allocator const &alloc) : values(alloc) {}
+
+        /// A container with count value-initialized elements
+        explicit index_vector(
+            size_type count, Allocator const &alloc= Allocator()) :
+            values(count, alloc) {}
+
+        /// A container with count copies of value
+        index_vector(
+            size_type count, T const &value,
+            Allocator const &alloc= Allocator()) :
+            values(count, value, alloc) {}
+
+        index_vector(
+            std::initializer_list<T> init,
+            Allocator const &alloc= Allocator()) :
+            values(init, alloc) {}
+
+        template <
+            typename InputIterator,
+            typename= typename std::iterator_traits<
+                InputIterator>::iterator_category>
+        index_vector(
+            InputIterator first, InputIterator last,
+            Allocator const &alloc= Allocator()) :
+            values(first, last, alloc) {}
+
+        /// Take ownership of the elements of an existing std::vector. The
+        /// element at position i has index Index(i).
+        explicit index_vector(storage_type values_) noexcept :
+            values(std::move(values_)) {}
+
+        /// Unchecked access to an element in release builds
+        reference operator[](Index const &index) noexcept {
+            assert(detail::to_position(index) < values.size());
+            return values[detail::to_position(index)];
+        }
+        const_reference operator[](Index const &index) const noexcept {
+            assert(detail::to_position(index) < values.size());
+            return values[detail::to_position(index)];
+        }
+
+        /// Checked access to an element
+        reference at(Index const &index) {
+            return values.at(detail::to_position(index));
+        }
+        const_reference at(Index const &index) const {
+            return values.at(detail::to_position(index));
+        }
+
+        reference front() noexcept {
+            return values.front();
+        }
+        const_reference front() const noexcept {
+            return values.front();
+        }
+        reference back() noexcept {
+            return values.back();
+        }
+        const_reference back() const noexcept {
+            return values.back();
+        }
+
+        T *data() noexcept {
+            return values.data();
+        }
+        T const *data() const noexcept {
+            return values.data();
+        }
+
+        iterator begin() noexcept {
+            return values.begin();
+        }
+        const_iterator begin() const noexcept {
+            return values.begin();
+        }
+        const_iterator cbegin() const noexcept {
+            return values.cbegin();
+        }
+        iterator end() noexcept {
+            return values.end();
+        }
+        const_iterator end() const noexcept {
+            return values.end();
+        }
+        const_iterator cend() const noexcept {
+            return values.cend();
+        }
+        reverse_iterator rbegin() noexcept {
+            return values.rbegin();
+        }
+        const_reverse_iterator rbegin() const noexcept {
+            return values.rbegin();
+        }
+        reverse_iterator rend() noexcept {
+            return values.rend();
+        }
+        const_reverse_iterator rend() const noexcept {
+            return values.rend();
+        }
+
+        /// The index of the first element
+        Index begin_index() const noexcept {
+            return detail::to_index<Index>(0);
+        }
+
+        /// One past the index of the last element, which is also the index
+        /// that the next element added with push_back or emplace_back will
+        /// have
+        Index end_index() const noexcept {
+            return detail::to_index<Index>(values.size());
+        }
+
+        /// The range of all valid indexes, from begin_index() to end_index()
+        index_range<Index> indexes() const noexcept {
+            return index_range<Index>(begin_index(), end_index());
+        }
+
+        /// Check if index refers to an element of the container
+        bool contains(Index const &index) const noexcept {
+            return detail::to_position(index) < values.size();
+        }
+
+        bool empty() const noexcept {
+            return values.empty();
+        }
+        size_type size() const noexcept {
+            return values.size();
+        }
+        size_type max_size() const noexcept {
+            return values.max_size();
+        }
+        size_type capacity() const noexcept {
+            return values.capacity();
+        }
+        void reserve(size_type new_capacity) {
+            values.reserve(new_capacity);
+        }
+        void shrink_to_fit() {
+            values.shrink_to_fit();
+        }
+
+        void clear() noexcept {
+            values.clear();
+        }
+
+        /// Add an element at the end, and return its index
+        Index push_back(T const &value) {
+            values.push_back(value);
+            return detail::to_index<Index>(values.size() - 1);
+        }
+        Index push_back(T &&value) {
+            values.push_back(std::move(value));
+            return detail::to_index<Index>(values.size() - 1);
+        }
+
+        /// Construct an element at the end, and return its index
+        template <typename... Args> Index emplace_back(Args &&... args) {
+            values.emplace_back(std::forward<Args>(args)...);
+            return detail::to_index<Index>(values.size() - 1);
+        }
+
+        void pop_back() {
+            values.pop_back();
+        }
+
+        void resize(size_type count) {
+            values.resize(count);
+        }
+        void resize(size_type count, T const &value) {
+            values.resize(count, value);
+        }
+
+        void swap(index_vector &other) noexcept {
+            values.swap(other.values);
+        }
+        friend void swap(index_vector &lhs, index_vector &rhs) noexcept {
+            lhs.swap(rhs);
+        }
+
+        /// Access the elements as a std::vector, where they are indexed by
+        /// position rather than Index
+        storage_type const &as_vector() const noexcept {
+            return values;
+        }
+
+        /// Release the elements as a std::vector
+        storage_type release() noexcept {
+            storage_type result;
+            result.swap(values);
+            return result;
+        }
+
+        friend bool
+        operator==(index_vector const &lhs, index_vector const &rhs) {
+            return lhs.values == rhs.values;
+        }
+        friend bool
+        operator!=(index_vector const &lhs, index_vector const &rhs) {
+            return lhs.values != rhs.values;
+        }
+
+    private:
+        storage_type values;
+    };
+} // namespace jss
+
+#endif
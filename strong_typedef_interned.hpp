@@ -0,0 +1,246 @@
+#ifndef JSS_STRONG_TYPEDEF_INTERNED_HPP
+#define JSS_STRONG_TYPEDEF_INTERNED_HPP
+#include "strong_typedef.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace jss {
+    /// The table of interned strings for interned_string<Tag>. There is a
+    /// single table for each Tag, which lives until the end of the program,
+    /// so interned strings must not be used during the destruction of
+    /// static objects. Each distinct string is stored once, and identified
+    /// by a 32-bit handle. The empty string has handle 0.
+    ///
+    /// The table is split into shards, selected by the hash of the text,
+    /// each with its own std::shared_mutex, so threads interning strings
+    /// that are already in the table share the lock, and threads adding
+    /// different strings rarely contend. Looking up the text of a handle
+    /// does not take a lock.
+    template <typename Tag> class intern_table {
+    public:
+        using handle_type= std::uint32_t;
+
+        /// The table for Tag
+        static intern_table &instance() {
+            static intern_table table;
+            return table;
+        }
+
+        intern_table(intern_table const &)= delete;
+        intern_table &operator=(intern_table const &)= delete;
+
+        ~intern_table() {
+            for(auto &segment : segments)
+                delete[] segment.load(std::memory_order_relaxed);
+        }
+
+        /// The handle for text, adding it to the table if it is not
+        /// already there. Throws std::length_error if the handles are
+        /// exhausted.
+        handle_type intern(std::string_view text) {
+            std::size_t const hash= std::hash<std::string_view>()(text);
+            shard &owner= shards[hash % shard_count];
+            {
+                std::shared_lock<std::shared_mutex> lock(owner.mutex);
+                auto const found= owner.handles.find(text);
+                if(found != owner.handles.end())
+                    return found->second;
+            }
+            std::unique_lock<std::shared_mutex> lock(owner.mutex);
+            auto const found= owner.handles.find(text);
+            if(found != owner.handles.end())
+                return found->second;
+            return add(owner, text);
+        }
+
+        /// The text for handle, which must have been returned by intern
+        std::string_view text(handle_type handle) const noexcept {
+            unsigned const index= segment_index(handle);
+            return segments[index].load(std::memory_order_acquire)
+                [handle - segment_start(index)];
+        }
+
+        /// The number of distinct strings in the table
+        std::size_t size() const noexcept {
+            return static_cast<std::size_t>(
+                next_handle.load(std::memory_order_relaxed));
+        }
+
+    private:
+        static constexpr std::size_t shard_count= 16;
+        /// The first segment holds handles 0 to first_segment_size-1, and
+        /// each later segment holds as many handles as all the segments
+        /// before it, so the segments never have to be moved
+        static constexpr unsigned first_segment_bits= 10;
+        static constexpr std::uint64_t first_segment_size=
+            std::uint64_t(1) << first_segment_bits;
+        static constexpr unsigned segment_count= 33 - first_segment_bits;
+        static constexpr std::uint64_t handle_limit= std::uint64_t(1) << 32;
+
+        /// The strings whose hashes select this shard. The strings are held
+        /// in a deque, so they never move, and the map and the segments can
+        /// refer to them.
+        struct shard {
+            std::shared_mutex mutex;
+            std::deque<std::string> strings;
+            std::unordered_map<std::string_view, handle_type> handles;
+        };
+
+        intern_table() : next_handle(0), segments{} {
+            intern(std::string_view());
+        }
+
+        static unsigned segment_index(handle_type handle) noexcept {
+            return handle < first_segment_size ?
+                       0 :
+                       detail::bit_width(handle) - first_segment_bits;
+        }
+
+        static std::uint64_t segment_start(unsigned index) noexcept {
+            return index ? first_segment_size << (index - 1) : 0;
+        }
+
+        static std::uint64_t segment_size(unsigned index) noexcept {
+            return index ? segment_start(index) : first_segment_size;
+        }
+
+        /// Add text to owner, whose mutex must be locked exclusively
+        handle_type add(shard &owner, std::string_view text) {
+            std::uint64_t const next=
+                next_handle.fetch_add(1, std::memory_order_relaxed);
+            if(next >= handle_limit) {
+                next_handle.fetch_sub(1, std::memory_order_relaxed);
+                throw std::length_error(
+                    "jss::intern_table: too many interned strings");
+            }
+            handle_type const handle= static_cast<handle_type>(next);
+            std::string_view *const segment=
+                get_segment(segment_index(handle));
+            std::string const &stored= owner.strings.emplace_back(text);
+            owner.handles.emplace(stored, handle);
+            segment[handle - segment_start(segment_index(handle))]= stored;
+            return handle;
+        }
+
+        /// The segment with the specified index, allocating it if this is
+        /// the first handle in it
+        std::string_view *get_segment(unsigned index) {
+            std::string_view *segment=
+                segments[index].load(std::memory_order_acquire);
+            if(segment)
+                return segment;
+            std::string_view *const fresh=
+                new std::string_view[segment_size(index)];
+            if(segments[index].compare_exchange_strong(
+                   segment, fresh, std::memory_order_acq_rel,
+                   std::memory_order_acquire))
+                return fresh;
+            delete[] fresh;
+            return segment;
+        }
+
+        shard shards[shard_count];
+        std::atomic<std::uint64_t> next_handle;
+        std::atomic<std::string_view *> segments[segment_count];
+    };
+
+    /// A string interned in the table for Tag, for string values that are
+    /// repeated many times, such as symbols and host names. An
+    /// interned_string holds only a 32-bit handle, so copying, equality and
+    /// hashing are as cheap as for an integer, and each distinct string is
+    /// stored once. Interned strings with different tags are different
+    /// types, and use different tables.
+    ///
+    /// Constructing an interned_string looks up the text in the table,
+    /// adding it if necessary. The text is only needed by view(), str(),
+    /// ordering and streaming, which look it up from the handle without
+    /// taking a lock. The ordering is that of the text, not of the handles.
+    /// Interned strings are never removed from the table.
+    template <typename Tag> class interned_string {
+    public:
+        using table_type= intern_table<Tag>;
+        using handle_type= typename table_type::handle_type;
+
+        /// The empty string
+        constexpr interned_string() noexcept : id(0) {}
+
+        /// The interned copy of text
+        explicit interned_string(std::string_view text) :
+            id(table_type::instance().intern(text)) {}
+
+        /// The 32-bit handle for the string
+        constexpr handle_type handle() const noexcept {
+            return id;
+        }
+
+        /// The text of the string, which is valid until the end of the
+        /// program
+        std::string_view view() const noexcept {
+            return id ? table_type::instance().text(id) : std::string_view();
+        }
+
+        /// A copy of the text of the string
+        std::string str() const {
+            return std::string(view());
+        }
+
+        bool empty() const noexcept {
+            return id == 0;
+        }
+
+        friend constexpr bool operator==(
+            interned_string const &lhs, interned_string const &rhs) noexcept {
+            return lhs.id == rhs.id;
+        }
+        friend constexpr bool operator!=(
+            interned_string const &lhs, interned_string const &rhs) noexcept {
+            return lhs.id != rhs.id;
+        }
+        friend bool operator<(
+            interned_string const &lhs, interned_string const &rhs) noexcept {
+            return lhs.id != rhs.id && lhs.view() < rhs.view();
+        }
+        friend bool operator>(
+            interned_string const &lhs, interned_string const &rhs) noexcept {
+            return rhs < lhs;
+        }
+        friend bool operator<=(
+            interned_string const &lhs, interned_string const &rhs) noexcept {
+            return !(rhs < lhs);
+        }
+        friend bool operator>=(
+            interned_string const &lhs, interned_string const &rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+        friend std::ostream &
+        operator<<(std::ostream &os, interned_string const &value) {
+            return os << value.view();
+        }
+
+    private:
+        handle_type id;
+    };
+} // namespace jss
+
+namespace std {
+    /// Interned strings are hashed by their handles
+    template <typename Tag> struct hash<jss::interned_string<Tag>> {
+        std::size_t
+        operator()(jss::interned_string<Tag> const &value) const noexcept {
+            return std::hash<std::uint32_t>()(value.handle());
+        }
+    };
+} // namespace std
+
+#endif
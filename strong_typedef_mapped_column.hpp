@@ -0,0 +1,379 @@
+#ifndef JSS_STRONG_TYPEDEF_MAPPED_COLUMN_HPP
+#define JSS_STRONG_TYPEDEF_MAPPED_COLUMN_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_serialization.hpp"
+#include "strong_typedef_span.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSS_MAPPED_COLUMN_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define JSS_MAPPED_COLUMN_USE_MMAP 0
+#include <memory>
+#endif
+
+namespace jss {
+    /// The header at the start of a column file. The values follow the
+    /// header immediately, so they start 64 bytes into the file, which is
+    /// suitably aligned for any value type when the file is mapped at a page
+    /// boundary.
+    struct mapped_column_header {
+        /// The file signature, "JSSCOL" followed by the format version
+        char magic[8];
+        /// The byte order of the values, 0 for little-endian and 1 for
+        /// big-endian
+        std::uint8_t order;
+        /// The kind of the value type: see value_kind
+        std::uint8_t kind;
+        /// The size of each value in bytes
+        std::uint16_t value_size;
+        std::uint32_t reserved;
+        /// The number of values
+        std::uint64_t count;
+        /// The name of the column, padded with null characters. It is
+        /// recorded when the file is written, and checked when it is
+        /// opened.
+        char name[40];
+
+        /// The kinds of value type
+        enum value_kind : std::uint8_t {
+            unsigned_integer,
+            signed_integer,
+            floating_point,
+            other
+        };
+
+        /// The current file signature
+        static constexpr char signature[8]= {'J', 'S', 'S', 'C',
+                                             'O', 'L', 0,   1};
+        /// The longest name that can be recorded
+        static constexpr std::size_t max_name_length= sizeof(name);
+    };
+
+    static_assert(sizeof(mapped_column_header) == 64);
+
+    /// How a column file is mapped
+    enum class mapped_column_mode {
+        /// The values cannot be changed
+        read_only,
+        /// The values can be changed in memory. Changes are private to the
+        /// mapped_column, and are never written back to the file.
+        copy_on_write
+    };
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// The kind of a value type, as recorded in a column file header
+        template <typename T>
+        constexpr mapped_column_header::value_kind column_value_kind() {
+            if constexpr(std::is_enum<T>::value) {
+                return column_value_kind<std::underlying_type_t<T>>();
+            } else if constexpr(std::is_floating_point<T>::value) {
+                return mapped_column_header::floating_point;
+            } else if constexpr(std::is_integral<T>::value) {
+                return std::is_signed<T>::value ?
+                           mapped_column_header::signed_integer :
+                           mapped_column_header::unsigned_integer;
+            } else {
+                return mapped_column_header::other;
+            }
+        }
+
+        /// Check that StrongTypedef can be stored in a column file, and
+        /// viewed in place when it is mapped
+        template <typename StrongTypedef>
+        constexpr bool check_column_type() {
+            static_assert(
+                is_serializable<StrongTypedef>::value,
+                "Column values must have the serializable property");
+            static_assert(
+                is_layout_transparent_v<StrongTypedef>,
+                "Column values must have the same layout as their underlying "
+                "value");
+            static_assert(
+                alignof(StrongTypedef) <= sizeof(mapped_column_header),
+                "Column values must not be over-aligned");
+            return true;
+        }
+
+        /// The header for a column of count values of StrongTypedef
+        template <typename StrongTypedef>
+        mapped_column_header
+        make_column_header(std::string_view name, std::uint64_t count) {
+            using value_type= typename StrongTypedef::underlying_value_type;
+            if(name.size() > mapped_column_header::max_name_length)
+                throw std::invalid_argument(
+                    "jss::mapped_column: the name is too long");
+            mapped_column_header header{};
+            std::memcpy(
+                header.magic, mapped_column_header::signature,
+                sizeof(header.magic));
+            header.order=
+                byte_order::native == byte_order::little ? 0 : 1;
+            header.kind= column_value_kind<value_type>();
+            header.value_size= static_cast<std::uint16_t>(sizeof(value_type));
+            header.count= count;
+            std::memcpy(header.name, name.data(), name.size());
+            return header;
+        }
+
+        /// Check that header describes a column of StrongTypedef called name
+        /// in the native byte order, throwing std::runtime_error if not
+        template <typename StrongTypedef>
+        void check_column_header(
+            mapped_column_header const &header, std::string_view name,
+            std::uint64_t file_size) {
+            mapped_column_header const expected=
+                make_column_header<StrongTypedef>(name, header.count);
+            if(std::memcmp(
+                   header.magic, expected.magic, sizeof(header.magic)) != 0)
+                throw std::runtime_error(
+                    "jss::mapped_column: not a column file");
+            if(header.order != expected.order)
+                throw std::runtime_error(
+                    "jss::mapped_column: the column is not in the native "
+                    "byte order");
+            if(header.kind != expected.kind ||
+               header.value_size != expected.value_size)
+                throw std::runtime_error(
+                    "jss::mapped_column: the column has a different value "
+                    "type");
+            if(std::memcmp(header.name, expected.name, sizeof(header.name)) !=
+               0)
+                throw std::runtime_error(
+                    "jss::mapped_column: the column has a different name");
+            if((file_size - sizeof(header)) / header.value_size <
+               header.count)
+                throw std::runtime_error(
+                    "jss::mapped_column: the file is truncated");
+        }
+    } // namespace detail
+
+    /// Write a column file holding the values of a contiguous range of a
+    /// serializable strong_typedef, with a header recording name, the value
+    /// type, the number of values and the byte order. The values are
+    /// written in the native byte order, as a single block. Throws
+    /// std::runtime_error if the file cannot be written.
+    template <
+        typename Range,
+        typename StrongTypedef= std::remove_cv_t<detail::element_t<Range>>>
+    void write_mapped_column(
+        std::string const &path, std::string_view name, Range const &values) {
+        static_assert(detail::check_column_type<StrongTypedef>());
+        auto const header= detail::make_column_header<StrongTypedef>(
+            name, static_cast<std::uint64_t>(std::size(values)));
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        os.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        serialize<byte_order::native>(os, values);
+        os.close();
+        if(!os)
+            throw std::runtime_error(
+                "jss::write_mapped_column: cannot write " + path);
+    }
+
+    /// A column file of values of StrongTypedef, as written by
+    /// write_mapped_column, mapped into memory. The values are used in
+    /// place, without being read or constructed, so opening even a very
+    /// large column is fast, and pages of the file are only read when they
+    /// are accessed.
+    ///
+    /// StrongTypedef must be serializable and layout-transparent. Opening a
+    /// file throws std::system_error if it cannot be opened or mapped, and
+    /// std::runtime_error if it is not a column of StrongTypedef with the
+    /// expected name in the native byte order.
+    ///
+    /// On platforms without mmap, the file is read into memory instead.
+    template <typename StrongTypedef> class mapped_column {
+        static_assert(detail::check_column_type<StrongTypedef>());
+
+    public:
+        using value_type= StrongTypedef;
+        using size_type= std::size_t;
+        using const_iterator= StrongTypedef const *;
+        using iterator= const_iterator;
+
+        /// An empty column, not associated with a file
+        mapped_column() noexcept= default;
+
+        /// Map the column file at path, which must have the name name
+        mapped_column(
+            std::string const &path, std::string_view name,
+            mapped_column_mode mode_= mapped_column_mode::read_only) :
+            mode(mode_) {
+            map(path, name);
+        }
+
+        mapped_column(mapped_column &&other) noexcept :
+            mapping(std::exchange(other.mapping, nullptr)),
+            mapping_size(std::exchange(other.mapping_size, 0)),
+            values_(std::exchange(other.values_, nullptr)),
+            count(std::exchange(other.count, 0)), mode(other.mode) {}
+
+        mapped_column &operator=(mapped_column &&other) noexcept {
+            mapped_column temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+
+        ~mapped_column() {
+            unmap();
+        }
+
+        void swap(mapped_column &other) noexcept {
+            std::swap(mapping, other.mapping);
+            std::swap(mapping_size, other.mapping_size);
+            std::swap(values_, other.values_);
+            std::swap(count, other.count);
+            std::swap(mode, other.mode);
+        }
+
+        /// The values of the column
+        span<StrongTypedef const> values() const noexcept {
+            return span<StrongTypedef const>(values_, count);
+        }
+
+        /// The values of the column, which can be changed in memory. This
+        /// requires copy_on_write mode.
+        span<StrongTypedef> mutable_values() noexcept {
+            assert(mode == mapped_column_mode::copy_on_write);
+            return span<StrongTypedef>(values_, count);
+        }
+
+        StrongTypedef const &operator[](size_type index) const noexcept {
+            assert(index < count);
+            return values_[index];
+        }
+
+        StrongTypedef const *data() const noexcept {
+            return values_;
+        }
+        const_iterator begin() const noexcept {
+            return values_;
+        }
+        const_iterator end() const noexcept {
+            return values_ + count;
+        }
+
+        size_type size() const noexcept {
+            return count;
+        }
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+    private:
+        [[noreturn]] static void throw_system_error(char const *what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+#if JSS_MAPPED_COLUMN_USE_MMAP
+        void map(std::string const &path, std::string_view name) {
+            int const fd= ::open(path.c_str(), O_RDONLY);
+            if(fd < 0)
+                throw_system_error("jss::mapped_column: cannot open file");
+            struct stat info;
+            if(::fstat(fd, &info) != 0) {
+                int const error= errno;
+                ::close(fd);
+                errno= error;
+                throw_system_error("jss::mapped_column: cannot read file size");
+            }
+            std::uint64_t const file_size=
+                static_cast<std::uint64_t>(info.st_size);
+            if(file_size < sizeof(mapped_column_header)) {
+                ::close(fd);
+                throw std::runtime_error(
+                    "jss::mapped_column: not a column file");
+            }
+            int const protection= mode == mapped_column_mode::read_only ?
+                                      PROT_READ :
+                                      PROT_READ | PROT_WRITE;
+            void *const address= ::mmap(
+                nullptr, static_cast<std::size_t>(file_size), protection,
+                MAP_PRIVATE, fd, 0);
+            int const error= errno;
+            ::close(fd);
+            if(address == MAP_FAILED) {
+                errno= error;
+                throw_system_error("jss::mapped_column: cannot map file");
+            }
+            mapping= address;
+            mapping_size= static_cast<std::size_t>(file_size);
+            use_mapping(name, file_size);
+        }
+
+        void unmap() noexcept {
+            if(mapping)
+                ::munmap(mapping, mapping_size);
+        }
+#else
+        void map(std::string const &path, std::string_view name) {
+            std::ifstream is(path, std::ios::binary | std::ios::ate);
+            if(!is)
+                throw_system_error("jss::mapped_column: cannot open file");
+            std::uint64_t const file_size=
+                static_cast<std::uint64_t>(is.tellg());
+            if(file_size < sizeof(mapped_column_header))
+                throw std::runtime_error(
+                    "jss::mapped_column: not a column file");
+            std::unique_ptr<mapped_column_header[]> buffer(
+                new mapped_column_header
+                    [(file_size + sizeof(mapped_column_header) - 1) /
+                     sizeof(mapped_column_header)]);
+            is.seekg(0);
+            if(!is.read(
+                   reinterpret_cast<char *>(buffer.get()),
+                   static_cast<std::streamsize>(file_size)))
+                throw_system_error("jss::mapped_column: cannot read file");
+            mapping= buffer.release();
+            mapping_size= static_cast<std::size_t>(file_size);
+            use_mapping(name, file_size);
+        }
+
+        void unmap() noexcept {
+            delete[] static_cast<mapped_column_header *>(mapping);
+        }
+#endif
+
+        /// Check the header of the mapped file, and find the values
+        void use_mapping(std::string_view name, std::uint64_t file_size) {
+            try {
+                auto const &header=
+                    *static_cast<mapped_column_header const *>(mapping);
+                detail::check_column_header<StrongTypedef>(
+                    header, name, file_size);
+                values_= reinterpret_cast<StrongTypedef *>(
+                    static_cast<std::byte *>(mapping) + sizeof(header));
+                count= static_cast<size_type>(header.count);
+            } catch(...) {
+                unmap();
+                mapping= nullptr;
+                throw;
+            }
+        }
+
+        void *mapping= nullptr;
+        std::size_t mapping_size= 0;
+        StrongTypedef *values_= nullptr;
+        size_type count= 0;
+        mapped_column_mode mode= mapped_column_mode::read_only;
+    };
+} // namespace jss
+
+#endif
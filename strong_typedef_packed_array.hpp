@@ -0,0 +1,427 @@
+#ifndef JSS_STRONG_TYPEDEF_PACKED_ARRAY_HPP
+#define JSS_STRONG_TYPEDEF_PACKED_ARRAY_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// A mask of the low Bits bits of a 64-bit word
+        template <unsigned Bits>
+        constexpr std::uint64_t low_bits_mask=
+            Bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << Bits) - 1;
+
+        /// Read the Bits bits starting at bit shift of *word, continuing
+        /// into word[1] if necessary. There is no branch: if the bits do not
+        /// cross into word[1], the bits taken from it are shifted out.
+        template <unsigned Bits>
+        constexpr std::uint64_t
+        extract_bits(std::uint64_t const *word, unsigned shift) noexcept {
+            std::uint64_t const low= word[0] >> shift;
+            std::uint64_t const high= (word[1] << 1) << (63 - shift);
+            return (low | high) & low_bits_mask<Bits>;
+        }
+
+        /// Replace the Bits bits starting at bit shift of *word, continuing
+        /// into word[1] if necessary, with the low Bits bits of value
+        template <unsigned Bits>
+        constexpr void deposit_bits(
+            std::uint64_t *word, unsigned shift, std::uint64_t value) noexcept {
+            constexpr std::uint64_t mask= low_bits_mask<Bits>;
+            word[0]= (word[0] & ~(mask << shift)) | (value << shift);
+            word[1]= (word[1] & ~((mask >> 1) >> (63 - shift))) |
+                     ((value >> 1) >> (63 - shift));
+        }
+    } // namespace detail
+
+    /// A sequence of values of StrongTypedef, each stored in exactly Bits
+    /// bits, for large arrays of values with a small range. StrongTypedef
+    /// must have an integral underlying type. Values of a signed type are
+    /// stored in two's complement, and sign-extended when read.
+    ///
+    /// Storing a value that does not fit in Bits bits throws
+    /// std::out_of_range. Since the elements are not addressable,
+    /// operator[] on a non-const packed_array returns a proxy reference that
+    /// converts to StrongTypedef and can be assigned from it. Iteration is
+    /// read-only, and decodes the values sequentially without computing
+    /// each position from scratch. unpack decodes a whole range of values
+    /// at once, with a branch-free loop that the compiler can vectorize.
+    template <typename StrongTypedef, unsigned Bits> class packed_array {
+        using underlying_type= typename StrongTypedef::underlying_value_type;
+
+        static_assert(
+            std::is_integral<underlying_type>::value,
+            "The strong_typedef must have an integral underlying type");
+        static_assert(
+            Bits > 0 && Bits <= 64 &&
+                Bits <= sizeof(underlying_type) * CHAR_BIT,
+            "The number of bits must be between 1 and the size of the "
+            "underlying type");
+
+        static constexpr bool nothrow_decode= std::is_nothrow_constructible<
+            StrongTypedef, underlying_type>::value;
+
+    public:
+        using value_type= StrongTypedef;
+        using size_type= std::size_t;
+        using difference_type= std::ptrdiff_t;
+        using const_reference= StrongTypedef;
+
+        /// The number of bits used for each value
+        static constexpr unsigned bits= Bits;
+
+        /// A proxy for an element of a packed_array
+        class reference {
+        public:
+            /// The value of the element
+            operator StrongTypedef() const noexcept(nothrow_decode) {
+                return array->get(index);
+            }
+
+            /// Replace the value of the element
+            reference &operator=(StrongTypedef const &value) {
+                array->set(index, value);
+                return *this;
+            }
+
+            /// Replace the value of the element with the value of another
+            reference &operator=(reference const &other) {
+                array->set(index, StrongTypedef(other));
+                return *this;
+            }
+
+        private:
+            friend class packed_array;
+
+            reference(packed_array *array_, size_type index_) noexcept :
+                array(array_), index(index_) {}
+
+            packed_array *array;
+            size_type index;
+        };
+
+        /// An iterator that decodes the values in order
+        class const_iterator {
+        public:
+            using iterator_category= std::forward_iterator_tag;
+            using value_type= StrongTypedef;
+            using difference_type= std::ptrdiff_t;
+            using pointer= void;
+            using reference= StrongTypedef;
+
+            const_iterator()= default;
+
+            StrongTypedef operator*() const noexcept(nothrow_decode) {
+                return decode(detail::extract_bits<Bits>(word, shift));
+            }
+
+            const_iterator &operator++() noexcept {
+                shift+= Bits;
+                word+= shift / 64;
+                shift%= 64;
+                return *this;
+            }
+
+            const_iterator operator++(int) noexcept {
+                const_iterator result(*this);
+                ++*this;
+                return result;
+            }
+
+            friend bool operator==(
+                const_iterator const &lhs, const_iterator const &rhs) noexcept {
+                return lhs.word == rhs.word && lhs.shift == rhs.shift;
+            }
+            friend bool operator!=(
+                const_iterator const &lhs, const_iterator const &rhs) noexcept {
+                return !(lhs == rhs);
+            }
+
+        private:
+            friend class packed_array;
+
+            const_iterator(
+                std::uint64_t const *word_, unsigned shift_) noexcept :
+                word(word_), shift(shift_) {}
+
+            std::uint64_t const *word= nullptr;
+            unsigned shift= 0;
+        };
+        using iterator= const_iterator;
+
+        /// An empty array
+        packed_array() : words(word_count(0)) {}
+
+        /// An array of count zero values
+        explicit packed_array(size_type count_) :
+            count(count_), words(word_count(count_)) {}
+
+        /// An array of count copies of value
+        packed_array(size_type count_, StrongTypedef const &value) :
+            packed_array() {
+            assign(count_, value);
+        }
+
+        /// Moving an array leaves the source empty, holding a single zero
+        /// word, so it can still be used. The move constructor allocates
+        /// that word for the source, so it can throw std::bad_alloc.
+        packed_array(packed_array &&other) :
+            count(other.count), words(word_count(0)) {
+            words.swap(other.words);
+            other.count= 0;
+        }
+
+        packed_array(packed_array const &)= default;
+
+        /// The source takes the words of this array, and keeps only the
+        /// first, so this does not allocate
+        packed_array &operator=(packed_array &&other) noexcept {
+            if(this != &other) {
+                words.swap(other.words);
+                count= other.count;
+                other.count= 0;
+                other.words.resize(word_count(0));
+                other.words.front()= 0;
+            }
+            return *this;
+        }
+
+        packed_array &operator=(packed_array const &)= default;
+
+        packed_array(std::initializer_list<StrongTypedef> init) :
+            packed_array(init.begin(), init.end()) {}
+
+        template <
+            typename InputIterator,
+            typename= typename std::iterator_traits<
+                InputIterator>::iterator_category>
+        packed_array(InputIterator first, InputIterator last) :
+            packed_array() {
+            for(; first != last; ++first)
+                push_back(*first);
+        }
+
+        /// Replace the contents with count copies of value
+        void assign(size_type count_, StrongTypedef const &value) {
+            std::uint64_t const raw= encode(value);
+            clear();
+            resize(count_);
+            for(size_type i= 0; i < count_; ++i)
+                deposit(i, raw);
+        }
+
+        /// Unchecked access to an element in release builds
+        reference operator[](size_type index) noexcept {
+            assert(index < count);
+            return reference(this, index);
+        }
+        StrongTypedef operator[](size_type index) const
+            noexcept(nothrow_decode) {
+            assert(index < count);
+            return get(index);
+        }
+
+        /// Checked access to an element
+        reference at(size_type index) {
+            check_index(index);
+            return reference(this, index);
+        }
+        StrongTypedef at(size_type index) const {
+            check_index(index);
+            return get(index);
+        }
+
+        StrongTypedef front() const noexcept(nothrow_decode) {
+            return get(0);
+        }
+        StrongTypedef back() const noexcept(nothrow_decode) {
+            return get(count - 1);
+        }
+
+        /// The value of an element
+        StrongTypedef get(size_type index) const noexcept(nothrow_decode) {
+            assert(index < count);
+            return decode(detail::extract_bits<Bits>(
+                words.data() + index * Bits / 64,
+                static_cast<unsigned>(index * Bits % 64)));
+        }
+
+        /// Replace the value of an element, throwing std::out_of_range if
+        /// the value does not fit
+        void set(size_type index, StrongTypedef const &value) {
+            assert(index < count);
+            deposit(index, encode(value));
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(words.data(), 0);
+        }
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+        const_iterator end() const noexcept {
+            return const_iterator(
+                words.data() + count * Bits / 64,
+                static_cast<unsigned>(count * Bits % 64));
+        }
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        bool empty() const noexcept {
+            return count == 0;
+        }
+        size_type size() const noexcept {
+            return count;
+        }
+        /// The number of elements that can be held without reallocating
+        size_type capacity() const noexcept {
+            return (words.capacity() - 1) * 64 / Bits;
+        }
+        void reserve(size_type new_capacity) {
+            words.reserve(word_count(new_capacity));
+        }
+        void shrink_to_fit() {
+            words.shrink_to_fit();
+        }
+
+        void push_back(StrongTypedef const &value) {
+            std::uint64_t const raw= encode(value);
+            words.resize(word_count(count + 1));
+            deposit(count, raw);
+            ++count;
+        }
+
+        void pop_back() noexcept {
+            assert(count != 0);
+            --count;
+            deposit(count, 0);
+        }
+
+        /// Change the number of elements. New elements are zero.
+        void resize(size_type new_count) {
+            if(new_count < count) {
+                for(size_type i= new_count; i < count; ++i)
+                    deposit(i, 0);
+            }
+            words.resize(word_count(new_count));
+            count= new_count;
+        }
+
+        void clear() noexcept {
+            count= 0;
+            words.resize(word_count(0));
+            words.front()= 0;
+        }
+
+        /// Decode the count values starting at index first into
+        /// [out,out+count). Whole groups of 64 values, which start on a word
+        /// boundary, are decoded with fixed shifts and word offsets, so the
+        /// compiler can vectorize the decoding.
+        void unpack(
+            size_type first, size_type count_, StrongTypedef *out) const
+            noexcept(nothrow_decode) {
+            assert(first <= count && count_ <= count - first);
+            size_type i= 0;
+            size_type const lead= std::min(
+                count_, (group_size - first % group_size) % group_size);
+            for(; i < lead; ++i)
+                out[i]= get(first + i);
+            std::uint64_t const *group=
+                words.data() + (first + i) / group_size * Bits;
+            size_type const groups= (count_ - i) / group_size;
+            for(size_type g= 0; g < groups; ++g)
+                unpack_group(
+                    group + g * Bits, out + i + g * group_size,
+                    std::make_index_sequence<group_size>());
+            i+= groups * group_size;
+            for(; i < count_; ++i)
+                out[i]= get(first + i);
+        }
+
+        /// Decode the values starting at index first into the elements of
+        /// out, which must not extend beyond the end of the array
+        void unpack(size_type first, span<StrongTypedef> out) const
+            noexcept(nothrow_decode) {
+            unpack(first, out.size(), out.data());
+        }
+
+        /// Replace the contents of out with all the values in the array
+        template <typename Allocator>
+        void unpack(std::vector<StrongTypedef, Allocator> &out) const {
+            out.resize(count);
+            unpack(0, count, out.data());
+        }
+
+    private:
+        /// The number of values in a group that starts and ends on a word
+        /// boundary
+        static constexpr size_type group_size= 64;
+
+        /// Decode the values of a group that starts at group
+        template <std::size_t... Offsets>
+        static void unpack_group(
+            std::uint64_t const *group, StrongTypedef *out,
+            std::index_sequence<Offsets...>) noexcept(nothrow_decode) {
+            ((out[Offsets]= decode(detail::extract_bits<Bits>(
+                  group + Offsets * Bits / 64, Offsets * Bits % 64))),
+             ...);
+        }
+
+        /// The number of words needed for count values, plus one so that
+        /// extract_bits and deposit_bits can always access the next word
+        static constexpr size_type word_count(size_type count_) noexcept {
+            return (count_ * Bits + 63) / 64 + 1;
+        }
+
+        static StrongTypedef
+        decode(std::uint64_t raw) noexcept(nothrow_decode) {
+            if constexpr(std::is_signed<underlying_type>::value) {
+                return StrongTypedef(static_cast<underlying_type>(
+                    static_cast<std::int64_t>(raw << (64 - Bits)) >>
+                    (64 - Bits)));
+            } else {
+                return StrongTypedef(static_cast<underlying_type>(raw));
+            }
+        }
+
+        static std::uint64_t encode(StrongTypedef const &value) {
+            std::uint64_t const raw=
+                static_cast<std::uint64_t>(value.underlying_value()) &
+                detail::low_bits_mask<Bits>;
+            if(!(decode(raw).underlying_value() == value.underlying_value()))
+                throw std::out_of_range(
+                    "jss::packed_array: value does not fit in the bits");
+            return raw;
+        }
+
+        void deposit(size_type index, std::uint64_t raw) noexcept {
+            detail::deposit_bits<Bits>(
+                words.data() + index * Bits / 64,
+                static_cast<unsigned>(index * Bits % 64), raw);
+        }
+
+        void check_index(size_type index) const {
+            if(index >= count)
+                throw std::out_of_range(
+                    "jss::packed_array: index out of range");
+        }
+
+        size_type count= 0;
+        /// The packed bits. All bits after the last element are zero.
+        std::vector<std::uint64_t> words;
+    };
+} // namespace jss
+
+#endif
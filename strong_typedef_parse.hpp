@@ -0,0 +1,274 @@
+#ifndef JSS_STRONG_TYPEDEF_PARSE_HPP
+#define JSS_STRONG_TYPEDEF_PARSE_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <charconv>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef __cpp_lib_to_chars
+#include <locale>
+#include <sstream>
+#include <string>
+#endif
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Parse a value of type T from the start of [first,last). Numbers
+        /// are parsed with std::from_chars, so parsing does not depend on
+        /// the locale; other types must be constructible from a
+        /// std::string_view, and use all the text.
+        template <typename T>
+        std::from_chars_result
+        parse_value(char const *first, char const *last, T &value) {
+            if constexpr(
+                std::is_integral<T>::value && !std::is_same<T, bool>::value) {
+                return std::from_chars(first, last, value);
+            } else if constexpr(std::is_floating_point<T>::value) {
+#ifdef __cpp_lib_to_chars
+                return std::from_chars(first, last, value);
+#else
+                std::istringstream is(std::string(first, last));
+                is.imbue(std::locale::classic());
+                T parsed;
+                if(!(is >> parsed))
+                    return {first, std::errc::invalid_argument};
+                value= parsed;
+                if(is.eof())
+                    return {last, std::errc()};
+                return {first + static_cast<std::ptrdiff_t>(is.tellg()),
+                        std::errc()};
+#endif
+            } else {
+                static_assert(
+                    std::is_constructible<T, std::string_view>::value,
+                    "The value type must be a number, or constructible from "
+                    "a std::string_view");
+                value= T(std::string_view(
+                    first, static_cast<std::size_t>(last - first)));
+                return {last, std::errc()};
+            }
+        }
+
+        /// Construct a StrongTypedef from a parsed value in result, so the
+        /// value is checked by any properties that restrict it, such as
+        /// bounded. Returns std::errc() on success. A value that a property
+        /// rejects by throwing std::out_of_range gives
+        /// std::errc::result_out_of_range, and one rejected by throwing
+        /// another std::logic_error gives std::errc::invalid_argument.
+        template <typename StrongTypedef>
+        std::errc make_parsed(
+            typename StrongTypedef::underlying_value_type &&value,
+            std::optional<StrongTypedef> &result) {
+            if constexpr(std::is_nothrow_constructible<
+                             StrongTypedef,
+                             typename StrongTypedef::underlying_value_type>::
+                             value) {
+                result.emplace(std::move(value));
+            } else {
+                try {
+                    result.emplace(std::move(value));
+                } catch(std::out_of_range const &) {
+                    return std::errc::result_out_of_range;
+                } catch(std::logic_error const &) {
+                    return std::errc::invalid_argument;
+                }
+            }
+            return std::errc();
+        }
+
+        /// Check if c ends a field of delimited text
+        constexpr bool is_field_end(char c, char delimiter) noexcept {
+            return c == delimiter || c == '\n' || c == '\r';
+        }
+    } // namespace detail
+
+    namespace strong_typedef_properties {
+        /// Add a stream operator to read the strong_typedef from a
+        /// std::istream, and allow it to be parsed from text with
+        /// jss::parse and jss::parse_delimited
+        struct parsable {
+            template <typename Derived, typename ValueType> struct mixin {
+                /// Read the underlying value from the stream. The
+                /// strong_typedef is only changed if the read succeeds, and
+                /// the value is accepted by any properties that restrict
+                /// it; if not, failbit is set.
+                friend std::istream &operator>>(std::istream &is, Derived &st) {
+                    ValueType value;
+                    if(is >> value) {
+                        std::optional<Derived> parsed;
+                        if(detail::make_parsed(std::move(value), parsed) ==
+                           std::errc())
+                            st= std::move(*parsed);
+                        else
+                            is.setstate(std::ios_base::failbit);
+                    }
+                    return is;
+                }
+            };
+        };
+    } // namespace strong_typedef_properties
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if T is a strong_typedef with the parsable property
+        template <typename T, typename= void>
+        struct is_parsable : std::false_type {};
+
+        template <typename T>
+        struct is_parsable<T, std::void_t<typename T::underlying_value_type>>
+            : std::is_base_of<
+                  strong_typedef_properties::parsable::mixin<
+                      T, typename T::underlying_value_type>,
+                  T> {};
+    } // namespace detail
+
+    /// Parse the whole of text as a value of the parsable strong_typedef
+    /// StrongTypedef. Returns an empty optional if text is not a valid
+    /// value, there is text left over, or the value is rejected by a
+    /// property that restricts the values of StrongTypedef.
+    template <
+        typename StrongTypedef,
+        typename= std::enable_if_t<detail::is_parsable<StrongTypedef>::value>>
+    std::optional<StrongTypedef> parse(std::string_view text) {
+        typename StrongTypedef::underlying_value_type value{};
+        char const *const last= text.data() + text.size();
+        auto const result= detail::parse_value(text.data(), last, value);
+        if(result.ec != std::errc() || result.ptr != last)
+            return std::nullopt;
+        std::optional<StrongTypedef> parsed;
+        if(detail::make_parsed(std::move(value), parsed) != std::errc())
+            return std::nullopt;
+        return parsed;
+    }
+
+    /// The result of parse_delimited
+    struct parse_delimited_result {
+        /// The number of values stored
+        std::size_t count;
+        /// The position in the text at which parsing stopped
+        char const *ptr;
+        /// std::errc() on success, or the reason parsing stopped early
+        std::errc ec;
+    };
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Parse delimited text as values of StrongTypedef, with the rules
+        /// described for jss::parse_delimited, and pass each value to
+        /// store, along with the number of values stored before it. Parsing
+        /// stops with std::errc::value_too_large once capacity values have
+        /// been stored.
+        template <typename StrongTypedef, typename Store>
+        parse_delimited_result parse_fields(
+            std::string_view text, char delimiter, std::size_t capacity,
+            Store &&store) {
+            using value_type= typename StrongTypedef::underlying_value_type;
+            char const *pos= text.data();
+            char const *const last= pos + text.size();
+            std::size_t count= 0;
+            while(pos != last) {
+                if(count == capacity)
+                    return {count, pos, std::errc::value_too_large};
+                char const *field_end= pos;
+                while(field_end != last && !is_field_end(*field_end, delimiter))
+                    ++field_end;
+                value_type value{};
+                auto const result= parse_value(pos, field_end, value);
+                if(result.ec != std::errc())
+                    return {count, pos, result.ec};
+                if(result.ptr != field_end)
+                    return {count, pos, std::errc::invalid_argument};
+                std::optional<StrongTypedef> parsed;
+                std::errc const ec= make_parsed(std::move(value), parsed);
+                if(ec != std::errc())
+                    return {count, pos, ec};
+                store(count, std::move(*parsed));
+                ++count;
+                pos= field_end;
+                if(pos != last) {
+                    bool const line_break= *pos == '\n' || *pos == '\r';
+                    if(*pos == '\r' && pos + 1 != last && pos[1] == '\n')
+                        ++pos;
+                    ++pos;
+                    if(pos == last && !line_break)
+                        return {count, pos, std::errc::invalid_argument};
+                }
+            }
+            return {count, pos, std::errc()};
+        }
+    } // namespace detail
+
+    /// Parse a sequence of values of a parsable strong_typedef from text,
+    /// and store them in successive elements of a contiguous range, without
+    /// allocating any memory. Values are separated by delimiter or line
+    /// breaks, so this can read a column of values, one per line, or a row of
+    /// comma-separated values. A single line break at the end of the text is
+    /// allowed, but a delimiter at the end of the text starts an empty final
+    /// field, which is invalid.
+    ///
+    /// Parsing stops at the first invalid value, with ec set to
+    /// std::errc::invalid_argument, or std::errc::result_out_of_range if the
+    /// number is too large. Values are checked by any properties that
+    /// restrict the values of the strong_typedef, and a rejected value is
+    /// reported in the same way, as described for detail::make_parsed. If
+    /// there are more values than elements in the
+    /// range, parsing stops with ec set to std::errc::value_too_large, and
+    /// ptr pointing at the first value not stored.
+    template <
+        typename Range,
+        typename= std::enable_if_t<
+            detail::is_contiguous_range<
+                std::remove_reference_t<Range>>::value &&
+            detail::is_parsable<std::remove_cv_t<detail::element_t<
+                std::remove_reference_t<Range>>>>::value>>
+    parse_delimited_result
+    parse_delimited(std::string_view text, char delimiter, Range &&out) {
+        using strong_type=
+            detail::element_t<std::remove_reference_t<Range>>;
+        static_assert(
+            !std::is_const<strong_type>::value,
+            "Cannot parse into a range of const values");
+        auto *data= std::data(out);
+        return detail::parse_fields<strong_type>(
+            text, delimiter, std::size(out),
+            [data](std::size_t index, strong_type &&value) {
+                data[index]= std::move(value);
+            });
+    }
+
+    /// Parse a sequence of values of a parsable strong_typedef from text,
+    /// as above, and append them to a std::vector. Space for all the values
+    /// is reserved up front, so the vector is reallocated at most once, and
+    /// not at all if it already has enough capacity. Each element is only
+    /// constructed from a parsed value, so StrongTypedef need not be default
+    /// constructible. If parsing stops early, the values parsed before the
+    /// error are kept.
+    template <
+        typename StrongTypedef, typename Allocator,
+        typename= std::enable_if_t<detail::is_parsable<StrongTypedef>::value>>
+    parse_delimited_result parse_delimited(
+        std::string_view text, char delimiter,
+        std::vector<StrongTypedef, Allocator> &out) {
+        std::size_t fields= text.empty() ? 0 : 1;
+        for(char c : text)
+            fields+= detail::is_field_end(c, delimiter);
+        out.reserve(out.size() + fields);
+        return detail::parse_fields<StrongTypedef>(
+            text, delimiter, fields,
+            [&out](std::size_t, StrongTypedef &&value) {
+                out.push_back(std::move(value));
+            });
+    }
+} // namespace jss
+
+#endif
@@ -0,0 +1,386 @@
+#ifndef JSS_STRONG_TYPEDEF_SERIALIZATION_HPP
+#define JSS_STRONG_TYPEDEF_SERIALIZATION_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace jss {
+    /// The order of the bytes of a serialized value
+    enum class byte_order {
+        little,
+        big,
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) &&               \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        native= big
+#else
+        native= little
+#endif
+    };
+
+    namespace strong_typedef_properties {
+        /// Allow this strong_typedef to be written with jss::serialize and
+        /// read with jss::deserialize, as the raw bytes of the underlying
+        /// value, which must be trivially copyable. Values read are checked
+        /// by any properties that restrict the value, such as bounded.
+        struct serializable {
+            template <typename Derived, typename ValueType> struct mixin {
+                static_assert(
+                    std::is_trivially_copyable<ValueType>::value,
+                    "Only strong_typedefs with a trivially copyable value "
+                    "type can be serializable");
+            };
+        };
+    } // namespace strong_typedef_properties
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if T is a strong_typedef with the serializable property
+        template <typename T, typename= void>
+        struct is_serializable : std::false_type {};
+
+        template <typename T>
+        struct is_serializable<
+            T, std::void_t<typename T::underlying_value_type>>
+            : std::is_base_of<
+                  strong_typedef_properties::serializable::mixin<
+                      T, typename T::underlying_value_type>,
+                  T> {};
+
+        /// Check if Range is a contiguous range of serializable values
+        template <typename Range, typename= void>
+        struct is_serializable_range : std::false_type {};
+
+        template <typename Range>
+        struct is_serializable_range<
+            Range,
+            std::enable_if_t<is_contiguous_range<Range>::value>>
+            : is_serializable<std::remove_cv_t<element_t<Range>>> {};
+
+        /// Check if T is a strong_typedef with a property that restricts its
+        /// values, so deserialized values must be checked by constructing a
+        /// T from them, rather than copying their bytes into place
+        template <typename T> struct validates_values : std::false_type {};
+
+        template <typename Tag, typename ValueType, typename... Properties>
+        struct validates_values<strong_typedef<Tag, ValueType, Properties...>>
+            : std::bool_constant<
+                  value_validator<ValueType, Properties...>::validates> {};
+
+        /// Check if a range of T can be read by copying its bytes directly
+        /// into place in the byte order Order
+        template <byte_order Order, typename T>
+        using is_directly_deserializable= std::bool_constant<
+            Order == byte_order::native && is_layout_transparent<T>::value &&
+            !validates_values<T>::value>;
+
+        constexpr std::uint16_t byte_swap(std::uint16_t value) noexcept {
+            return static_cast<std::uint16_t>((value >> 8) | (value << 8));
+        }
+        constexpr std::uint32_t byte_swap(std::uint32_t value) noexcept {
+            return ((value & 0xff000000u) >> 24) |
+                   ((value & 0x00ff0000u) >> 8) |
+                   ((value & 0x0000ff00u) << 8) | ((value & 0x000000ffu) << 24);
+        }
+        constexpr std::uint64_t byte_swap(std::uint64_t value) noexcept {
+            return (std::uint64_t(byte_swap(std::uint32_t(value))) << 32) |
+                   byte_swap(std::uint32_t(value >> 32));
+        }
+
+        /// The unsigned integer type with the specified size
+        template <std::size_t Size> struct unsigned_of_size;
+        template <> struct unsigned_of_size<2> { using type= std::uint16_t; };
+        template <> struct unsigned_of_size<4> { using type= std::uint32_t; };
+        template <> struct unsigned_of_size<8> { using type= std::uint64_t; };
+
+        /// Write the bytes of value to out in the order Order
+        template <byte_order Order, typename T>
+        void store_bytes(T const &value, std::byte *out) noexcept {
+            if constexpr(Order == byte_order::native || sizeof(T) == 1) {
+                std::memcpy(out, &value, sizeof(T));
+            } else {
+                static_assert(
+                    std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                    "Only arithmetic and enum values can be converted to a "
+                    "non-native byte order: use byte_order::native");
+                typename unsigned_of_size<sizeof(T)>::type bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                bits= byte_swap(bits);
+                std::memcpy(out, &bits, sizeof(T));
+            }
+        }
+
+        /// Read the bytes of value from in, which are in the order Order
+        template <byte_order Order, typename T>
+        void load_bytes(std::byte const *in, T &value) noexcept {
+            if constexpr(Order == byte_order::native || sizeof(T) == 1) {
+                std::memcpy(&value, in, sizeof(T));
+            } else {
+                static_assert(
+                    std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                    "Only arithmetic and enum values can be converted from a "
+                    "non-native byte order: use byte_order::native");
+                typename unsigned_of_size<sizeof(T)>::type bits;
+                std::memcpy(&bits, in, sizeof(T));
+                bits= byte_swap(bits);
+                std::memcpy(&value, &bits, sizeof(T));
+            }
+        }
+
+        /// Values of a range are converted through a buffer of this size when
+        /// they cannot be copied directly
+        constexpr std::size_t serialization_buffer_size= 4096;
+    } // namespace detail
+
+    /// The number of bytes used to serialize a value of the serializable
+    /// strong_typedef StrongTypedef
+    template <typename StrongTypedef>
+    constexpr std::size_t serialized_size_v=
+        sizeof(typename StrongTypedef::underlying_value_type);
+
+    /// The number of bytes used to serialize value
+    template <
+        typename StrongTypedef,
+        typename= std::enable_if_t<
+            detail::is_serializable<StrongTypedef>::value>>
+    constexpr std::size_t serialized_size(StrongTypedef const &) noexcept {
+        return serialized_size_v<StrongTypedef>;
+    }
+
+    /// The number of bytes used to serialize all the values in a contiguous
+    /// range
+    template <
+        typename Range,
+        typename= std::enable_if_t<detail::is_serializable_range<Range>::value>,
+        typename= void>
+    std::size_t serialized_size(Range const &values) noexcept {
+        using element= std::remove_cv_t<detail::element_t<Range const>>;
+        return std::size(values) * serialized_size_v<element>;
+    }
+
+    /// Write the underlying value of value to the buffer at out, with the
+    /// bytes in the order Order. Returns a pointer just past the bytes
+    /// written.
+    template <
+        byte_order Order= byte_order::little, typename StrongTypedef,
+        typename= std::enable_if_t<
+            detail::is_serializable<StrongTypedef>::value>>
+    std::byte *serialize(StrongTypedef const &value, std::byte *out) noexcept {
+        detail::store_bytes<Order>(value.underlying_value(), out);
+        return out + serialized_size_v<StrongTypedef>;
+    }
+
+    /// Write all the values in a contiguous range to the buffer at out, with
+    /// the bytes of each in the order Order. If Order is the native byte
+    /// order and the values are layout-transparent, this is a single
+    /// memcpy. Returns a pointer just past the bytes written.
+    template <
+        byte_order Order= byte_order::little, typename Range,
+        typename= std::enable_if_t<detail::is_serializable_range<Range>::value>,
+        typename= void>
+    std::byte *serialize(Range const &values, std::byte *out) noexcept {
+        using element= std::remove_cv_t<detail::element_t<Range const>>;
+        auto const *data= std::data(values);
+        std::size_t const count= std::size(values);
+        if constexpr(
+            Order == byte_order::native &&
+            is_layout_transparent<element>::value) {
+            std::size_t const bytes= count * serialized_size_v<element>;
+            if(bytes)
+                std::memcpy(out, data, bytes);
+            return out + bytes;
+        } else {
+            for(std::size_t i= 0; i < count; ++i)
+                out= serialize<Order>(data[i], out);
+            return out;
+        }
+    }
+
+    /// Read a value from the buffer at in, where the bytes are in the order
+    /// Order. Returns a pointer just past the bytes read. If StrongTypedef
+    /// has a property that restricts its values, the value read is checked
+    /// by constructing a StrongTypedef from it, so an invalid value throws
+    /// the exception thrown by the property, such as std::out_of_range, and
+    /// value is unchanged.
+    template <
+        byte_order Order= byte_order::little, typename StrongTypedef,
+        typename= std::enable_if_t<
+            detail::is_serializable<StrongTypedef>::value>>
+    std::byte const *
+    deserialize(std::byte const *in, StrongTypedef &value) noexcept(
+        !detail::validates_values<StrongTypedef>::value) {
+        if constexpr(detail::validates_values<StrongTypedef>::value) {
+            typename StrongTypedef::underlying_value_type raw;
+            detail::load_bytes<Order>(in, raw);
+            value= StrongTypedef(raw);
+        } else {
+            detail::load_bytes<Order>(in, value.underlying_value());
+        }
+        return in + serialized_size_v<StrongTypedef>;
+    }
+
+    /// Read values from the buffer at in into every element of a
+    /// contiguous range, where the bytes of each are in the order Order. If
+    /// Order is the native byte order and the values are
+    /// layout-transparent, and not restricted by any property, this is a
+    /// single memcpy. Returns a pointer just past the bytes read. Restricted
+    /// values are checked one at a time, as above, so if one is invalid,
+    /// the exception propagates, and only the preceding elements have been
+    /// replaced.
+    template <
+        byte_order Order= byte_order::little, typename Range,
+        typename= std::enable_if_t<detail::is_serializable_range<
+            std::remove_reference_t<Range>>::value>,
+        typename= void>
+    std::byte const *
+    deserialize(std::byte const *in, Range &&values) noexcept(
+        !detail::validates_values<std::remove_cv_t<
+            detail::element_t<std::remove_reference_t<Range>>>>::value) {
+        using element= detail::element_t<std::remove_reference_t<Range>>;
+        static_assert(
+            !std::is_const<element>::value,
+            "Cannot deserialize into a range of const values");
+        auto *data= std::data(values);
+        std::size_t const count= std::size(values);
+        if constexpr(
+            detail::is_directly_deserializable<Order, element>::value) {
+            std::size_t const bytes= count * serialized_size_v<element>;
+            if(bytes)
+                std::memcpy(data, in, bytes);
+            return in + bytes;
+        } else {
+            for(std::size_t i= 0; i < count; ++i)
+                in= deserialize<Order>(in, data[i]);
+            return in;
+        }
+    }
+
+    /// Write the underlying value of value to a stream, with the bytes in
+    /// the order Order
+    template <
+        byte_order Order= byte_order::little, typename StrongTypedef,
+        typename= std::enable_if_t<
+            detail::is_serializable<StrongTypedef>::value>>
+    std::ostream &serialize(std::ostream &os, StrongTypedef const &value) {
+        std::byte buffer[serialized_size_v<StrongTypedef>];
+        serialize<Order>(value, buffer);
+        return os.write(reinterpret_cast<char const *>(buffer), sizeof(buffer));
+    }
+
+    /// Write all the values in a contiguous range to a stream, with the
+    /// bytes of each in the order Order. If Order is the native byte order
+    /// and the values are layout-transparent, this is a single write of the
+    /// whole range; otherwise the values are converted in chunks.
+    template <
+        byte_order Order= byte_order::little, typename Range,
+        typename= std::enable_if_t<detail::is_serializable_range<Range>::value>,
+        typename= void>
+    std::ostream &serialize(std::ostream &os, Range const &values) {
+        using element= std::remove_cv_t<detail::element_t<Range const>>;
+        auto const *data= std::data(values);
+        std::size_t const count= std::size(values);
+        if constexpr(
+            Order == byte_order::native &&
+            is_layout_transparent<element>::value) {
+            return os.write(
+                reinterpret_cast<char const *>(data),
+                static_cast<std::streamsize>(
+                    count * serialized_size_v<element>));
+        } else {
+            constexpr std::size_t chunk=
+                detail::serialization_buffer_size / serialized_size_v<element>;
+            std::byte buffer[chunk * serialized_size_v<element>];
+            for(std::size_t i= 0; i < count && os; i+= chunk) {
+                std::size_t const n= count - i < chunk ? count - i : chunk;
+                std::byte *const end=
+                    serialize<Order>(span<element const>(data + i, n), buffer);
+                os.write(
+                    reinterpret_cast<char const *>(buffer), end - buffer);
+            }
+            return os;
+        }
+    }
+
+    /// Read a value from a stream, where the bytes are in the order Order.
+    /// If the read fails, or the value read is rejected by a property that
+    /// restricts the values of StrongTypedef by throwing a
+    /// std::logic_error, value is unchanged and the failbit of the stream
+    /// is set.
+    template <
+        byte_order Order= byte_order::little, typename StrongTypedef,
+        typename= std::enable_if_t<
+            detail::is_serializable<StrongTypedef>::value>>
+    std::istream &deserialize(std::istream &is, StrongTypedef &value) {
+        std::byte buffer[serialized_size_v<StrongTypedef>];
+        if(is.read(reinterpret_cast<char *>(buffer), sizeof(buffer))) {
+            if constexpr(detail::validates_values<StrongTypedef>::value) {
+                try {
+                    deserialize<Order>(buffer, value);
+                } catch(std::logic_error const &) {
+                    is.setstate(std::ios_base::failbit);
+                }
+            } else {
+                deserialize<Order>(buffer, value);
+            }
+        }
+        return is;
+    }
+
+    /// Read values from a stream into every element of a contiguous range,
+    /// where the bytes of each are in the order Order. If the read fails,
+    /// or a value is rejected by a property that restricts the values, as
+    /// above, the failbit of the stream is set, and the contents of the
+    /// range are unspecified.
+    template <
+        byte_order Order= byte_order::little, typename Range,
+        typename= std::enable_if_t<detail::is_serializable_range<
+            std::remove_reference_t<Range>>::value>,
+        typename= void>
+    std::istream &deserialize(std::istream &is, Range &&values) {
+        using element= detail::element_t<std::remove_reference_t<Range>>;
+        static_assert(
+            !std::is_const<element>::value,
+            "Cannot deserialize into a range of const values");
+        auto *data= std::data(values);
+        std::size_t const count= std::size(values);
+        if constexpr(
+            detail::is_directly_deserializable<Order, element>::value) {
+            return is.read(
+                reinterpret_cast<char *>(data),
+                static_cast<std::streamsize>(
+                    count * serialized_size_v<element>));
+        } else {
+            constexpr std::size_t chunk=
+                detail::serialization_buffer_size / serialized_size_v<element>;
+            std::byte buffer[chunk * serialized_size_v<element>];
+            for(std::size_t i= 0; i < count; i+= chunk) {
+                std::size_t const n= count - i < chunk ? count - i : chunk;
+                if(!is.read(
+                       reinterpret_cast<char *>(buffer),
+                       static_cast<std::streamsize>(
+                           n * serialized_size_v<element>)))
+                    break;
+                if constexpr(detail::validates_values<element>::value) {
+                    try {
+                        deserialize<Order>(buffer, span<element>(data + i, n));
+                    } catch(std::logic_error const &) {
+                        is.setstate(std::ios_base::failbit);
+                        break;
+                    }
+                } else {
+                    deserialize<Order>(buffer, span<element>(data + i, n));
+                }
+            }
+            return is;
+        }
+    }
+} // namespace jss
+
+#endif
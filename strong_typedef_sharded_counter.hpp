@@ -0,0 +1,138 @@
+#ifndef JSS_STRONG_TYPEDEF_SHARDED_COUNTER_HPP
+#define JSS_STRONG_TYPEDEF_SHARDED_COUNTER_HPP
+#include "strong_typedef.hpp"
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/// The size of a cache line, used to keep the shards of a sharded_counter
+/// on separate cache lines. Define this before including the header to
+/// override it, e.g. to 128 for processors that fetch pairs of cache lines.
+#ifndef JSS_CACHE_LINE_SIZE
+#define JSS_CACHE_LINE_SIZE 64
+#endif
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// A small number identifying the calling thread. Threads are
+        /// numbered in the order in which they first call this function, so
+        /// the first N threads to use a sharded_counter get different
+        /// shards.
+        inline std::size_t thread_shard_index() noexcept {
+            static std::atomic<std::size_t> next_index(0);
+            thread_local std::size_t const index=
+                next_index.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+    } // namespace detail
+
+    /// A counter of type StrongTypedef that can be updated from many threads
+    /// without contending on a single cache line. The count is split over
+    /// ShardCount shards, each on its own cache line, and each thread adds
+    /// to its own shard with a relaxed atomic operation. Reading the counter
+    /// adds up all the shards, so reads are slower than updates, and a read
+    /// concurrent with updates sees some, but not necessarily all, of them.
+    ///
+    /// StrongTypedef must have the self_addable property (e.g. from
+    /// addable), and an arithmetic underlying type. The total is computed
+    /// with the strong_typedef's own operator+, so only values of the same
+    /// strong_typedef can be added to the counter. ShardCount must be a
+    /// power of two.
+    template <typename StrongTypedef, std::size_t ShardCount= 16>
+    class sharded_counter {
+        using underlying_type= typename StrongTypedef::underlying_value_type;
+
+        static_assert(
+            std::is_base_of<
+                strong_typedef_properties::self_addable::mixin<
+                    StrongTypedef, underlying_type>,
+                StrongTypedef>::value,
+            "The counter type must have the self_addable property");
+        static_assert(
+            std::is_arithmetic<underlying_type>::value,
+            "The counter type must have an arithmetic underlying type");
+        static_assert(
+            ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0,
+            "The number of shards must be a power of two");
+
+        /// One shard of the counter, on its own cache line
+        struct alignas(JSS_CACHE_LINE_SIZE) shard {
+            std::atomic<underlying_type> value{underlying_type()};
+        };
+
+    public:
+        using value_type= StrongTypedef;
+
+        /// The number of shards
+        static constexpr std::size_t shard_count= ShardCount;
+
+        /// A counter with a value-initialized count
+        sharded_counter()= default;
+
+        sharded_counter(sharded_counter const &)= delete;
+        sharded_counter &operator=(sharded_counter const &)= delete;
+
+        /// Add amount to the calling thread's shard
+        void add(StrongTypedef const &amount) noexcept {
+            auto &value= local_shard().value;
+            if constexpr(std::is_integral<underlying_type>::value) {
+                value.fetch_add(
+                    amount.underlying_value(), std::memory_order_relaxed);
+            } else {
+                underlying_type old= value.load(std::memory_order_relaxed);
+                while(!value.compare_exchange_weak(
+                    old, old + amount.underlying_value(),
+                    std::memory_order_relaxed)) {
+                }
+            }
+        }
+
+        sharded_counter &operator+=(StrongTypedef const &amount) noexcept {
+            add(amount);
+            return *this;
+        }
+
+        /// Add one to the count. This requires the pre_incrementable
+        /// property.
+        template <
+            typename S= StrongTypedef,
+            typename= std::enable_if_t<std::is_base_of<
+                strong_typedef_properties::pre_incrementable::mixin<
+                    S, underlying_type>,
+                S>::value>>
+        sharded_counter &operator++() noexcept {
+            add(StrongTypedef(underlying_type(1)));
+            return *this;
+        }
+
+        /// The total of all the shards
+        StrongTypedef load() const noexcept {
+            StrongTypedef total{underlying_type()};
+            for(auto const &s : shards)
+                total= total + StrongTypedef(
+                                   s.value.load(std::memory_order_relaxed));
+            return total;
+        }
+
+        /// Reset every shard to zero, and return the total of the values
+        /// they held
+        StrongTypedef reset() noexcept {
+            StrongTypedef total{underlying_type()};
+            for(auto &s : shards)
+                total= total + StrongTypedef(s.value.exchange(
+                                   underlying_type(),
+                                   std::memory_order_relaxed));
+            return total;
+        }
+
+    private:
+        shard &local_shard() noexcept {
+            return shards[detail::thread_shard_index() & (ShardCount - 1)];
+        }
+
+        shard shards[ShardCount];
+    };
+} // namespace jss
+
+#endif
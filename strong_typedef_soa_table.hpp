@@ -0,0 +1,273 @@
+#ifndef JSS_STRONG_TYPEDEF_SOA_TABLE_HPP
+#define JSS_STRONG_TYPEDEF_SOA_TABLE_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_index_vector.hpp"
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Find the position of T in Types, which must contain T exactly once
+        template <typename T, typename... Types> struct type_position;
+
+        template <typename T, typename... Rest>
+        struct type_position<T, T, Rest...>
+            : std::integral_constant<std::size_t, 0> {
+            static_assert(
+                !std::disjunction<std::is_same<T, Rest>...>::value,
+                "The column type must be unique to be used to select a column");
+        };
+
+        template <typename T, typename First, typename... Rest>
+        struct type_position<T, First, Rest...>
+            : std::integral_constant<
+                  std::size_t, 1 + type_position<T, Rest...>::value> {};
+    } // namespace detail
+
+    /// A non-owning view of a contiguous sequence of T, where the elements
+    /// can only be accessed by the strong_typedef index type Index. Indexes
+    /// are only checked with assert, so release builds have no bounds
+    /// checks.
+    template <typename Index, typename T> class index_span {
+        static_assert(
+            detail::is_index_type<Index>::value,
+            "The index type must be an ordered, incrementable strong_typedef "
+            "with an integral underlying type");
+
+    public:
+        using index_type= Index;
+        using element_type= T;
+        using value_type= std::remove_cv_t<T>;
+        using size_type= std::size_t;
+        using reference= T &;
+        using pointer= T *;
+        using iterator= T *;
+
+        constexpr index_span() noexcept : ptr(nullptr), count(0) {}
+
+        /// A view of count elements starting at data, where data[0] has
+        /// index Index(0)
+        constexpr index_span(T *data, size_type count_) noexcept :
+            ptr(data), count(count_) {}
+
+        /// A view of a non-const index_span as const
+        template <
+            typename U,
+            typename= std::enable_if_t<
+                !std::is_same<U, T>::value &&
+                std::is_convertible<U (*)[], T (*)[]>::value>>
+        constexpr index_span(index_span<Index, U> const &other) noexcept :
+            ptr(other.data()), count(other.size()) {}
+
+        reference operator[](Index const &index) const noexcept {
+            assert(detail::to_position(index) < count);
+            return ptr[detail::to_position(index)];
+        }
+
+        constexpr pointer data() const noexcept {
+            return ptr;
+        }
+        constexpr size_type size() const noexcept {
+            return count;
+        }
+        constexpr bool empty() const noexcept {
+            return count == 0;
+        }
+
+        constexpr iterator begin() const noexcept {
+            return ptr;
+        }
+        constexpr iterator end() const noexcept {
+            return ptr + count;
+        }
+
+        /// The range of all valid indexes
+        index_range<Index> indexes() const noexcept {
+            return index_range<Index>(
+                detail::to_index<Index>(0), detail::to_index<Index>(count));
+        }
+
+    private:
+        T *ptr;
+        size_type count;
+    };
+
+    /// A table with a row for each value of the strong_typedef Id, where
+    /// each column is stored contiguously in its own std::vector
+    /// (structure-of-arrays layout). Scanning a single column therefore only
+    /// touches the memory for that column. Rows are only accessed by Id,
+    /// which must be an ordered, incrementable strong_typedef with an
+    /// integral underlying type; the row added by push_back has the next
+    /// Id in sequence.
+    ///
+    /// Columns can be selected by position, or by type if that type is used
+    /// for only one column, which is natural when each column is itself a
+    /// strong_typedef.
+    template <typename Id, typename... Columns> class soa_table {
+        static_assert(
+            detail::is_index_type<Id>::value,
+            "The Id type must be an ordered, incrementable strong_typedef "
+            "with an integral underlying type");
+        static_assert(sizeof...(Columns) > 0, "A table must have a column");
+        static_assert(
+            !std::disjunction<std::is_same<Columns, bool>...>::value,
+            "std::vector<bool> is not contiguous: use a strong_typedef of "
+            "bool for a boolean column");
+
+        template <std::size_t I>
+        using column_t= std::tuple_element_t<I, std::tuple<Columns...>>;
+
+    public:
+        using id_type= Id;
+        using size_type= std::size_t;
+
+        /// The number of columns
+        static constexpr std::size_t column_count= sizeof...(Columns);
+
+        soa_table()= default;
+
+        /// Add a row with the specified values, and return its Id. If adding
+        /// a value to any column throws, the table is left unchanged.
+        Id push_back(Columns... values) {
+            size_type const old_size= size();
+            try {
+                push_back_impl(
+                    std::index_sequence_for<Columns...>(),
+                    std::move(values)...);
+            } catch(...) {
+                std::apply(
+                    [old_size](auto &... column) {
+                        (column.erase(column.begin() + old_size, column.end()),
+                         ...);
+                    },
+                    columns);
+                throw;
+            }
+            return detail::to_index<Id>(old_size);
+        }
+
+        /// Remove the last row
+        void pop_back() {
+            std::apply(
+                [](auto &... column) { (column.pop_back(), ...); }, columns);
+        }
+
+        /// Resize the table to count rows. New rows have value-initialized
+        /// values
+        void resize(size_type count) {
+            std::apply(
+                [count](auto &... column) { (column.resize(count), ...); },
+                columns);
+        }
+
+        /// Reserve space for count rows in every column
+        void reserve(size_type count) {
+            std::apply(
+                [count](auto &... column) { (column.reserve(count), ...); },
+                columns);
+        }
+
+        void clear() noexcept {
+            std::apply(
+                [](auto &... column) { (column.clear(), ...); }, columns);
+        }
+
+        size_type size() const noexcept {
+            return std::get<0>(columns).size();
+        }
+        bool empty() const noexcept {
+            return std::get<0>(columns).empty();
+        }
+
+        /// One past the Id of the last row, which is also the Id that the
+        /// next row added with push_back will have
+        Id end_id() const noexcept {
+            return detail::to_index<Id>(size());
+        }
+
+        /// The range of Ids of all the rows
+        index_range<Id> ids() const noexcept {
+            return index_range<Id>(detail::to_index<Id>(0), end_id());
+        }
+
+        /// Check if id refers to a row of the table
+        bool contains(Id const &id) const noexcept {
+            return detail::to_position(id) < size();
+        }
+
+        /// The value of column I for the row id
+        template <std::size_t I> column_t<I> &get(Id const &id) noexcept {
+            assert(contains(id));
+            return std::get<I>(columns)[detail::to_position(id)];
+        }
+        template <std::size_t I>
+        column_t<I> const &get(Id const &id) const noexcept {
+            assert(contains(id));
+            return std::get<I>(columns)[detail::to_position(id)];
+        }
+
+        /// The value of the column of type Column for the row id
+        template <typename Column> Column &get(Id const &id) noexcept {
+            return get<detail::type_position<Column, Columns...>::value>(id);
+        }
+        template <typename Column>
+        Column const &get(Id const &id) const noexcept {
+            return get<detail::type_position<Column, Columns...>::value>(id);
+        }
+
+        /// A view of the whole of column I, indexed by Id
+        template <std::size_t I> index_span<Id, column_t<I>> column() noexcept {
+            auto &storage= std::get<I>(columns);
+            return index_span<Id, column_t<I>>(storage.data(), storage.size());
+        }
+        template <std::size_t I>
+        index_span<Id, column_t<I> const> column() const noexcept {
+            auto const &storage= std::get<I>(columns);
+            return index_span<Id, column_t<I> const>(
+                storage.data(), storage.size());
+        }
+
+        /// A view of the whole of the column of type Column, indexed by Id
+        template <typename Column> index_span<Id, Column> column() noexcept {
+            return column<detail::type_position<Column, Columns...>::value>();
+        }
+        template <typename Column>
+        index_span<Id, Column const> column() const noexcept {
+            return column<detail::type_position<Column, Columns...>::value>();
+        }
+
+        /// References to all the values in the row id
+        std::tuple<Columns &...> row(Id const &id) noexcept {
+            return row_impl(id, std::index_sequence_for<Columns...>());
+        }
+        std::tuple<Columns const &...> row(Id const &id) const noexcept {
+            return row_impl(id, std::index_sequence_for<Columns...>());
+        }
+
+    private:
+        template <std::size_t... I>
+        void push_back_impl(std::index_sequence<I...>, Columns &&... values) {
+            (std::get<I>(columns).push_back(std::move(values)), ...);
+        }
+
+        template <std::size_t... I>
+        std::tuple<Columns &...>
+        row_impl(Id const &id, std::index_sequence<I...>) noexcept {
+            return std::tuple<Columns &...>(get<I>(id)...);
+        }
+        template <std::size_t... I>
+        std::tuple<Columns const &...>
+        row_impl(Id const &id, std::index_sequence<I...>) const noexcept {
+            return std::tuple<Columns const &...>(get<I>(id)...);
+        }
+
+        std::tuple<std::vector<Columns>...> columns;
+    };
+} // namespace jss
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef JSS_STRONG_TYPEDEF_SPAN_HPP
+#define JSS_STRONG_TYPEDEF_SPAN_HPP
+#include "strong_typedef.hpp"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus > 201703L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        /// Detect types that can be used as contiguous ranges
+        template <typename T, typename= void>
+        struct is_contiguous_range : std::false_type {};
+
+        template <typename T>
+        struct is_contiguous_range<
+            T, std::void_t<
+                   decltype(std::data(std::declval<T &>())),
+                   decltype(std::size(std::declval<T &>()))>>
+            : std::true_type {};
+
+        /// The type of an element of a contiguous range
+        template <typename Range>
+        using element_t= std::remove_reference_t<
+            decltype(*std::data(std::declval<Range &>()))>;
+
+        /// Apply the const qualification of From to To
+        template <typename From, typename To>
+        using copy_const_t=
+            std::conditional_t<std::is_const<From>::value, To const, To>;
+    } // namespace detail
+
+#ifdef __cpp_lib_span
+    /// A non-owning view of a contiguous sequence of T
+    template <typename T> using span= std::span<T>;
+#else
+    /// A non-owning view of a contiguous sequence of T. This provides the
+    /// commonly-used subset of the interface of C++20 std::span, which is
+    /// used instead where it is available.
+    template <typename T> class span {
+    public:
+        using element_type= T;
+        using value_type= std::remove_cv_t<T>;
+        using size_type= std::size_t;
+        using difference_type= std::ptrdiff_t;
+        using pointer= T *;
+        using const_pointer= T const *;
+        using reference= T &;
+        using const_reference= T const &;
+        using iterator= T *;
+
+        /// An empty span
+        constexpr span() noexcept : ptr(nullptr), count(0) {}
+
+        /// A span of count elements starting at data
+        constexpr span(T *data, size_type count_) noexcept :
+            ptr(data), count(count_) {}
+
+        /// A span of the elements from first to last
+        constexpr span(T *first, T *last) noexcept :
+            ptr(first), count(static_cast<size_type>(last - first)) {}
+
+        /// A span of all the elements of a contiguous range, such as a
+        /// std::vector or an array
+        template <
+            typename Range,
+            typename= std::enable_if_t<
+                !std::is_same<std::remove_cv_t<Range>, span>::value &&
+                detail::is_contiguous_range<Range>::value &&
+                std::is_convertible<
+                    decltype(std::data(std::declval<Range &>())),
+                    T *>::value>>
+        constexpr span(Range &range) noexcept(noexcept(std::data(range))) :
+            ptr(std::data(range)), count(std::size(range)) {}
+
+        /// A span of elements of a span of a less-qualified type
+        template <
+            typename U,
+            typename= std::enable_if_t<
+                !std::is_same<U, T>::value &&
+                std::is_convertible<U (*)[], T (*)[]>::value>>
+        constexpr span(span<U> const &other) noexcept :
+            ptr(other.data()), count(other.size()) {}
+
+        constexpr pointer data() const noexcept {
+            return ptr;
+        }
+        constexpr size_type size() const noexcept {
+            return count;
+        }
+        constexpr size_type size_bytes() const noexcept {
+            return count * sizeof(T);
+        }
+        constexpr bool empty() const noexcept {
+            return count == 0;
+        }
+
+        constexpr reference operator[](size_type index) const noexcept {
+            return ptr[index];
+        }
+        constexpr reference front() const noexcept {
+            return ptr[0];
+        }
+        constexpr reference back() const noexcept {
+            return ptr[count - 1];
+        }
+
+        constexpr iterator begin() const noexcept {
+            return ptr;
+        }
+        constexpr iterator end() const noexcept {
+            return ptr + count;
+        }
+
+        /// The first n elements
+        constexpr span first(size_type n) const noexcept {
+            return span(ptr, n);
+        }
+        /// The last n elements
+        constexpr span last(size_type n) const noexcept {
+            return span(ptr + (count - n), n);
+        }
+        /// n elements starting at offset, or all the remaining elements if n
+        /// is not specified
+        constexpr span subspan(
+            size_type offset, size_type n= static_cast<size_type>(-1)) const
+            noexcept {
+            return span(
+                ptr + offset, n == static_cast<size_type>(-1) ? count - offset :
+                                                                n);
+        }
+
+    private:
+        T *ptr;
+        size_type count;
+    };
+
+    template <typename Range>
+    span(Range &)->span<detail::element_t<Range>>;
+#endif
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Detect spans, which do not own their elements
+        template <typename T> struct is_span : std::false_type {};
+
+        template <typename T> struct is_span<span<T>> : std::true_type {};
+
+        /// Detect contiguous ranges whose elements outlive an expression of
+        /// type Range&&: lvalues, and spans of any value category. A span of
+        /// the elements of a temporary container would dangle.
+        template <typename Range>
+        using is_borrowed_contiguous_range= std::conjunction<
+            is_contiguous_range<Range>,
+            std::disjunction<
+                std::is_lvalue_reference<Range>,
+                is_span<std::remove_cv_t<std::remove_reference_t<Range>>>>>;
+    } // namespace detail
+
+    /// View a contiguous range of layout-transparent strong_typedef values
+    /// as a span of the underlying values, without copying. The constness
+    /// of the elements is preserved. The range must be an lvalue or a span,
+    /// so temporary containers are rejected rather than left dangling.
+    template <
+        typename Range,
+        typename= std::enable_if_t<
+            detail::is_borrowed_contiguous_range<Range>::value>>
+    auto as_underlying_span(Range &&range) noexcept {
+        using strong_type= detail::element_t<Range>;
+        static_assert(
+            is_layout_transparent<strong_type>::value,
+            "The element type must be a layout-transparent strong_typedef");
+        using value_type= detail::copy_const_t<
+            strong_type,
+            typename std::remove_cv_t<strong_type>::underlying_value_type>;
+        return span<value_type>(
+            reinterpret_cast<value_type *>(std::data(range)),
+            std::size(range));
+    }
+
+    /// View count strong_typedef values starting at data as a span of the
+    /// underlying values, without copying
+    template <typename StrongTypedef>
+    auto as_underlying_span(StrongTypedef *data, std::size_t count) noexcept {
+        return as_underlying_span(span<StrongTypedef>(data, count));
+    }
+
+    /// View a contiguous range of values as a span of the layout-transparent
+    /// strong_typedef StrongTypedef, without copying. This is intended for
+    /// buffers that hold the raw values, such as memory that has been filled
+    /// with memcpy or a memory-mapped file. The element type of the range
+    /// must be the underlying type of StrongTypedef. The constness of the
+    /// elements is preserved. As with as_underlying_span, the range must be
+    /// an lvalue or a span.
+    template <
+        typename StrongTypedef, typename Range,
+        typename= std::enable_if_t<
+            detail::is_borrowed_contiguous_range<Range>::value>>
+    auto as_strong_span(Range &&range) noexcept {
+        using raw_type= detail::element_t<Range>;
+        static_assert(
+            is_layout_transparent<StrongTypedef>::value,
+            "The target type must be a layout-transparent strong_typedef");
+        static_assert(
+            std::is_same<
+                std::remove_cv_t<raw_type>,
+                typename StrongTypedef::underlying_value_type>::value,
+            "The element type must be the underlying type of the "
+            "strong_typedef");
+        using strong_type= detail::copy_const_t<raw_type, StrongTypedef>;
+        return span<strong_type>(
+            reinterpret_cast<strong_type *>(std::data(range)),
+            std::size(range));
+    }
+
+    /// View count raw values starting at data as a span of the
+    /// layout-transparent strong_typedef StrongTypedef, without copying
+    template <typename StrongTypedef, typename ValueType>
+    auto as_strong_span(ValueType *data, std::size_t count) noexcept {
+        return as_strong_span<StrongTypedef>(span<ValueType>(data, count));
+    }
+} // namespace jss
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef JSS_STRONG_TYPEDEF_VIEW_HPP
+#define JSS_STRONG_TYPEDEF_VIEW_HPP
+#include "strong_typedef.hpp"
+#include "strong_typedef_span.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace jss {
+    /// Internal implementation namespace
+    namespace detail {
+        template <typename CharT, typename Traits, typename Allocator>
+        struct view_type<std::basic_string<CharT, Traits, Allocator>> {
+            using type= std::basic_string_view<CharT, Traits>;
+        };
+
+        template <typename T, typename Allocator>
+        struct view_type<std::vector<T, Allocator>> {
+            using type= span<T const>;
+        };
+
+        template <typename T> using view_type_t= typename view_type<T>::type;
+
+        /// The view type of StrongTypedef. This has no type member if the
+        /// underlying type has no view type.
+        template <typename StrongTypedef, typename= void>
+        struct view_of_type {};
+
+        template <typename Tag, typename ValueType, typename... Properties>
+        struct view_of_type<
+            strong_typedef<Tag, ValueType, Properties...>,
+            std::void_t<view_type_t<ValueType>>> {
+            using type= strong_typedef<
+                Tag, view_type_t<ValueType>, Properties...>;
+        };
+    } // namespace detail
+
+    /// The non-owning view type for StrongTypedef, whose underlying type
+    /// must be a std::basic_string or a std::vector. This is a
+    /// strong_typedef with the same tag and properties as StrongTypedef,
+    /// holding a std::basic_string_view or a jss::span of const elements
+    /// respectively, so view_of<Name> is comparable, hashable and streamable
+    /// if Name is. Only the properties that make sense for the view type
+    /// can be used: std::string_view supports all the comparison, hashing
+    /// and streaming properties, but jss::span supports none of them.
+    ///
+    /// A view_of<StrongTypedef> can be implicitly constructed from a
+    /// StrongTypedef, which must outlive it, and explicitly constructed from
+    /// a view of the underlying type, so functions taking a view_of<Name>
+    /// can be called with either a Name or raw characters, without
+    /// allocating. Views of different strong_typedefs are different types.
+    template <typename StrongTypedef>
+    using view_of= typename detail::view_of_type<StrongTypedef>::type;
+
+#define JSS_DEFINE_VIEW_COMPARISON(op_symbol)                                  \
+    template <typename Tag, typename ValueType, typename... Properties>        \
+    constexpr auto operator op_symbol(                                         \
+        view_of<strong_typedef<Tag, ValueType, Properties...>> const &lhs,     \
+        strong_typedef<Tag, ValueType, Properties...> const                    \
+            &rhs) noexcept(noexcept(lhs op_symbol lhs))                        \
+        ->decltype(lhs op_symbol lhs) {                                        \
+        return lhs op_symbol view_of<                                          \
+                   strong_typedef<Tag, ValueType, Properties...>>(rhs);        \
+    }                                                                          \
+                                                                               \
+    template <typename Tag, typename ValueType, typename... Properties>        \
+    constexpr auto operator op_symbol(                                         \
+        strong_typedef<Tag, ValueType, Properties...> const &lhs,              \
+        view_of<strong_typedef<Tag, ValueType, Properties...>> const           \
+            &rhs) noexcept(noexcept(rhs op_symbol rhs))                        \
+        ->decltype(rhs op_symbol rhs) {                                        \
+        return view_of<strong_typedef<Tag, ValueType, Properties...>>(lhs)     \
+            op_symbol rhs;                                                     \
+    }
+
+    /// Compare a StrongTypedef with a view_of<StrongTypedef> in either
+    /// order, without copying the viewed value. Each operator is only
+    /// available if the view supports it, so the owner and the view can be
+    /// compared if the owner has the corresponding property.
+    JSS_DEFINE_VIEW_COMPARISON(==)
+    JSS_DEFINE_VIEW_COMPARISON(!=)
+    JSS_DEFINE_VIEW_COMPARISON(<)
+    JSS_DEFINE_VIEW_COMPARISON(>)
+    JSS_DEFINE_VIEW_COMPARISON(<=)
+    JSS_DEFINE_VIEW_COMPARISON(>=)
+
+    /// The key type used for heterogeneous lookup with the
+    /// transparent_hash, transparent_equal_to and transparent_less function
+    /// objects
+    template <typename StrongTypedef> using strong_view= view_of<StrongTypedef>;
+
+    /// Internal implementation namespace
+    namespace detail {
+        /// Check if T is StrongTypedef or a strong_view of it
+        template <typename StrongTypedef, typename T>
+        struct is_strong_key
+            : std::disjunction<
+                  std::is_same<T, StrongTypedef>,
+                  std::is_same<T, strong_view<StrongTypedef>>> {};
+
+        template <typename StrongTypedef, typename T>
+        using enable_if_strong_key_t=
+            std::enable_if_t<is_strong_key<StrongTypedef, T>::value, int>;
+
+        /// The value of key as a view
+        template <typename StrongTypedef, typename Key>
+        constexpr strong_view<StrongTypedef> as_view(Key const &key) noexcept {
+            return strong_view<StrongTypedef>(key);
+        }
+    } // namespace detail
+
+    /// A transparent hash function object for the hashable strong_typedef
+    /// StrongTypedef, which accepts either a StrongTypedef or a
+    /// strong_view<StrongTypedef>, and gives the same hash for both. The
+    /// hash is computed with the hash policy of StrongTypedef, applied to
+    /// the string view: the standard guarantees that std::hash gives the
+    /// same value for a string and a string_view of the same text.
+    template <typename StrongTypedef> struct transparent_hash {
+        using is_transparent= void;
+        using hash_policy= typename StrongTypedef::hash_policy;
+
+        template <
+            typename Key,
+            detail::enable_if_strong_key_t<StrongTypedef, Key> = 0>
+        std::size_t operator()(Key const &key) const noexcept {
+            return hash_policy()(
+                detail::as_view<StrongTypedef>(key).underlying_value());
+        }
+    };
+
+    /// A transparent equality function object, which compares any
+    /// combination of StrongTypedef and strong_view<StrongTypedef> values
+    template <typename StrongTypedef> struct transparent_equal_to {
+        using is_transparent= void;
+
+        template <
+            typename Lhs, typename Rhs,
+            detail::enable_if_strong_key_t<StrongTypedef, Lhs> = 0,
+            detail::enable_if_strong_key_t<StrongTypedef, Rhs> = 0>
+        constexpr bool
+        operator()(Lhs const &lhs, Rhs const &rhs) const noexcept {
+            return detail::as_view<StrongTypedef>(lhs).underlying_value() ==
+                   detail::as_view<StrongTypedef>(rhs).underlying_value();
+        }
+    };
+
+    /// A transparent ordering function object, which compares any
+    /// combination of StrongTypedef and strong_view<StrongTypedef> values
+    template <typename StrongTypedef> struct transparent_less {
+        using is_transparent= void;
+
+        template <
+            typename Lhs, typename Rhs,
+            detail::enable_if_strong_key_t<StrongTypedef, Lhs> = 0,
+            detail::enable_if_strong_key_t<StrongTypedef, Rhs> = 0>
+        constexpr bool
+        operator()(Lhs const &lhs, Rhs const &rhs) const noexcept {
+            return detail::as_view<StrongTypedef>(lhs).underlying_value() <
+                   detail::as_view<StrongTypedef>(rhs).underlying_value();
+        }
+    };
+} // namespace jss
+
+#endif
@@ -1,8 +1,40 @@
 #include "strong_typedef.hpp"
+#include "strong_typedef_arithmetic.hpp"
+#include "strong_typedef_atomic.hpp"
+#include "strong_typedef_bounded.hpp"
+#include "strong_typedef_bulk.hpp"
+#include "strong_typedef_flags.hpp"
+#include "strong_typedef_compact.hpp"
+#include "strong_typedef_format.hpp"
+#include "strong_typedef_id_allocator.hpp"
+#include "strong_typedef_id_map.hpp"
+#include "strong_typedef_index_vector.hpp"
+#include "strong_typedef_interned.hpp"
+#include "strong_typedef_mapped_column.hpp"
+#include "strong_typedef_packed_array.hpp"
+#include "strong_typedef_parse.hpp"
+#include "strong_typedef_serialization.hpp"
+#include "strong_typedef_sharded_counter.hpp"
+#include "strong_typedef_soa_table.hpp"
+#include "strong_typedef_span.hpp"
+#include "strong_typedef_view.hpp"
 #include <type_traits>
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 void test_strong_typedef_is_not_original() {
     std::cout << __FUNCTION__ << std::endl;
@@ -150,6 +182,85 @@ void test_can_get_underlying_value_and_type() {
     assert(st.underlying_value().i == 42);
 }
 
+void test_free_underlying_value_function() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using ST= jss::strong_typedef<struct Tag, std::string>;
+
+    static_assert(
+        std::is_same<
+            decltype(underlying_value(std::declval<ST &>())),
+            std::string &>::value,
+        "underlying_value of an lvalue must be an lvalue reference");
+    static_assert(
+        std::is_same<
+            decltype(underlying_value(std::declval<ST const &>())),
+            std::string const &>::value,
+        "underlying_value of a const lvalue must be a const reference");
+    static_assert(
+        std::is_same<
+            decltype(underlying_value(std::declval<ST>())),
+            std::string &&>::value,
+        "underlying_value of an rvalue must be an rvalue reference");
+    static_assert(
+        std::is_same<
+            decltype(jss::underlying_value(std::declval<int &>())),
+            int &>::value,
+        "underlying_value of a plain value must be that value");
+
+    ST st("hello");
+    underlying_value(st)+= " world";
+    assert(st.underlying_value() == "hello world");
+    std::string s= underlying_value(std::move(st));
+    assert(s == "hello world");
+}
+
+void test_operators_accept_implicitly_convertible_operands() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using namespace jss::strong_typedef_properties;
+    using ST= jss::strong_typedef<
+        struct Tag, int, comparable, addable, subtractable, incrementable,
+        bitwise_not, streamable>;
+
+    ST a(1);
+    ST b(2);
+
+    assert(std::ref(a) < b);
+    assert(b > std::cref(a));
+    assert(std::cref(a) <= std::ref(a));
+    assert(!(std::ref(a) >= b));
+    assert(std::cref(a) == a);
+    assert(std::ref(a) != b);
+    assert((std::ref(a) + b).underlying_value() == 3);
+    assert((b - std::cref(a)).underlying_value() == 1);
+    assert((~std::cref(a)).underlying_value() == ~1);
+
+    ++std::ref(a);
+    assert(a == b);
+    std::ref(a)+= std::cref(b);
+    assert(a.underlying_value() == 4);
+    std::ref(a)++;
+    assert(a.underlying_value() == 5);
+
+    std::ostringstream os;
+    os << std::cref(a);
+    assert(os.str() == "5");
+
+    using Saturating= jss::strong_typedef<
+        struct SaturatingTag, std::uint8_t, saturating_arithmetic>;
+
+    Saturating c(200);
+    Saturating d(100);
+    assert((std::ref(c) + d).underlying_value() == 255);
+    assert((d - std::cref(c)).underlying_value() == 0);
+    assert((std::cref(d) * std::uint8_t(2)).underlying_value() == 200);
+    std::ref(c)+= std::cref(d);
+    assert(c.underlying_value() == 255);
+    std::ref(d)-= std::uint8_t(150);
+    assert(d.underlying_value() == 0);
+}
+
 void test_strong_typedef_is_equality_comparable_if_tagged_as_such() {
     std::cout << __FUNCTION__ << std::endl;
 
@@ -524,6 +635,71 @@ void test_strong_typedef_is_hashable_if_tagged_as_such() {
     assert(std::hash<ST>()(st) == std::hash<std::string>()(s));
 }
 
+template <typename HashPolicy> std::size_t count_low_bit_buckets() {
+    using ID= jss::strong_typedef<
+        struct IDTag, unsigned,
+        jss::strong_typedef_properties::hashable_with<HashPolicy>>;
+    std::vector<bool> used(1024);
+    std::size_t count= 0;
+    for(unsigned i= 0; i < 1024; ++i) {
+        std::size_t const bucket= std::hash<ID>()(ID(i * 1024)) & 1023;
+        count+= !used[bucket];
+        used[bucket]= true;
+    }
+    return count;
+}
+
+void test_hashable_with_hash_policy() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    namespace policies= jss::hash_policies;
+
+    using ID= jss::strong_typedef<
+        struct IDTag, unsigned long long,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::hashable_with<policies::fibonacci>>;
+    static_assert(sizeof(test_hashable<ID>(0)) == sizeof(small_result));
+    static_assert(sizeof(ID) == sizeof(unsigned long long));
+
+    // Combining hashable with hashable_with is rejected by a static_assert
+    // when the strong_typedef is instantiated
+    using Both= jss::strong_typedef<
+        struct BothTag, int, jss::strong_typedef_properties::hashable,
+        jss::strong_typedef_properties::hashable_with<policies::fibonacci>>;
+    static_assert(jss::detail::hash_property_count<ID>::value == 1);
+    static_assert(jss::detail::hash_property_count<Both>::value == 2);
+
+    ID const id(42);
+    assert(std::hash<ID>()(id) == policies::fibonacci()(42ull));
+    assert(jss::hash<ID>()(id) == std::hash<ID>()(id));
+    assert(
+        (jss::hash<ID, policies::wyhash_mix>()(id) ==
+         policies::wyhash_mix()(42ull)));
+    assert(
+        (jss::hash<unsigned long long, policies::xxh3_avalanche>()(42) ==
+         policies::xxh3_avalanche()(42ull)));
+    assert(jss::hash<int>()(42) == std::hash<int>()(42));
+
+    using StandardID= jss::strong_typedef<
+        struct StandardIDTag, std::string,
+        jss::strong_typedef_properties::hashable>;
+    assert(
+        jss::hash<StandardID>()(StandardID("hello")) ==
+        std::hash<std::string>()("hello"));
+
+    // IDs that are multiples of the table size all land in the same bucket
+    // with an identity hash, but are spread out by each of the mixers
+    assert(count_low_bit_buckets<policies::fibonacci>() > 512);
+    assert(count_low_bit_buckets<policies::xxh3_avalanche>() > 512);
+    assert(count_low_bit_buckets<policies::wyhash_mix>() > 512);
+
+    std::unordered_set<ID> set;
+    for(unsigned long long i= 0; i < 100; ++i)
+        set.insert(ID(i));
+    assert(set.count(ID(99)) == 1);
+    assert(set.count(ID(100)) == 0);
+}
+
 template <typename T>
 typename std::enable_if<
     std::is_convertible<
@@ -1831,6 +2007,2070 @@ void test_adding_two_strong_typedefs() {
     assert(sts3.underlying_value() == "worldhello");
     assert(sts4.underlying_value() == "helloworld");
 }
+template <typename T, typename U>
+typename std::enable_if<
+    sizeof(jss::bulk::multiply(
+        std::declval<std::vector<T> const &>(),
+        std::declval<std::vector<U> const &>(),
+        std::declval<std::vector<T> &>()),
+           0) != 0,
+    small_result>::type
+test_bulk_multiply(int);
+template <typename T, typename U> large_result test_bulk_multiply(...);
+
+template <typename T>
+typename std::enable_if<
+    sizeof(jss::bulk::minimum(std::declval<std::vector<T> const &>())) != 0,
+    small_result>::type
+test_bulk_minimum(int);
+template <typename T> large_result test_bulk_minimum(...);
+
+void test_bulk_operations_follow_properties() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Price= jss::strong_typedef<
+        struct PriceTag, double, jss::strong_typedef_properties::addable,
+        jss::strong_typedef_properties::multiplicable,
+        jss::strong_typedef_properties::ordered>;
+    using Quantity= jss::strong_typedef<
+        struct QuantityTag, double,
+        jss::strong_typedef_properties::mixed_addable<Price>>;
+
+    static_assert(
+        sizeof(test_bulk_multiply<Price, Price>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_bulk_multiply<Price, double>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_bulk_multiply<Quantity, Quantity>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_bulk_multiply<Price, Quantity>(0)) == sizeof(large_result));
+    static_assert(sizeof(test_bulk_minimum<Price>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_bulk_minimum<Quantity>(0)) == sizeof(large_result));
+
+    std::vector<Price> prices;
+    std::vector<Quantity> quantities;
+    for(int i= 0; i < 11; ++i) {
+        prices.push_back(Price(i * 1.5));
+        quantities.push_back(Quantity(i));
+    }
+    std::vector<Price> out(prices.size());
+
+    jss::bulk::multiply(prices, prices, out);
+    assert(out[3].underlying_value() == 4.5 * 4.5);
+    jss::bulk::multiply(prices, 2.0, out);
+    assert(out[10].underlying_value() == 30.0);
+
+    std::vector<Quantity> totals(quantities.size());
+    jss::bulk::add(quantities, prices, totals);
+    assert(totals[4].underlying_value() == 10.0);
+
+    jss::bulk::fused_multiply_add(prices, 2.0, prices, out);
+    assert(out[2].underlying_value() == 9.0);
+
+    jss::bulk::transform(
+        prices, out, [](Price p) { return p * p; });
+    assert(out[2].underlying_value() == 9.0);
+
+    Price const sum= jss::bulk::reduce(prices);
+    assert(sum.underlying_value() == 82.5);
+    std::vector<Price> const few(prices.begin(), prices.begin() + 3);
+    assert(jss::bulk::reduce(few, Price(1)).underlying_value() == 5.5);
+
+    using Total= jss::strong_typedef<
+        struct TotalTag, double,
+        jss::strong_typedef_properties::generic_mixed_addable>;
+    static_assert(!std::is_constructible<Total, Price const &>::value);
+    assert(jss::bulk::reduce(prices, Total(0.5)).underlying_value() == 83.0);
+    assert(jss::bulk::reduce(few, Total(0.5)).underlying_value() == 5.0);
+
+    std::vector<std::uint8_t> const bytes(1000, 200);
+    assert(jss::bulk::reduce(bytes, std::uint64_t(7)) == 200007);
+
+    std::vector<Price> shuffled{Price(3), Price(-2), Price(8), Price(1),
+                                Price(5), Price(9), Price(0)};
+    assert(jss::bulk::minimum(shuffled).underlying_value() == -2);
+    assert(jss::bulk::maximum(shuffled).underlying_value() == 9);
+
+    bool mask[7];
+    jss::bulk::compare(shuffled, Price(3), mask, std::less<>());
+    assert(!mask[0] && mask[1] && !mask[2] && mask[3] && mask[6]);
+}
+void test_layout_transparency() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Index= jss::strong_typedef<
+        struct IndexTag, int, jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable,
+        jss::strong_typedef_properties::addable,
+        jss::strong_typedef_properties::hashable,
+        jss::strong_typedef_properties::streamable>;
+    using Name= jss::strong_typedef<struct NameTag, std::string>;
+
+    static_assert(jss::is_layout_transparent<Index>::value);
+    static_assert(jss::is_layout_transparent_v<Index const>);
+    static_assert(sizeof(Index) == sizeof(int));
+    static_assert(alignof(Index) == alignof(int));
+    static_assert(!jss::is_layout_transparent<Name>::value);
+    static_assert(!jss::is_layout_transparent<int>::value);
+
+    std::vector<Index> indexes{Index(1), Index(2), Index(3)};
+    jss::span<int> raw= jss::as_underlying_span(indexes);
+    assert(raw.size() == 3);
+    assert(raw.data() == &indexes[0].underlying_value());
+    raw[1]= 42;
+    assert(indexes[1].underlying_value() == 42);
+
+    std::vector<Index> const &const_indexes= indexes;
+    jss::span<int const> const_raw= jss::as_underlying_span(const_indexes);
+    assert(const_raw[2] == 3);
+
+    int buffer[]= {5, 6, 7, 8};
+    jss::span<Index> strong= jss::as_strong_span<Index>(buffer);
+    assert(strong.size() == 4);
+    assert(strong[3] == Index(8));
+    ++strong[0];
+    assert(buffer[0] == 6);
+
+    jss::span<Index const> strong_const=
+        jss::as_strong_span<Index>(static_cast<int const *>(buffer), 2);
+    assert(strong_const.size() == 2);
+    assert(strong_const[1] == Index(6));
+
+    std::vector<Index> copy(4);
+    std::memcpy(copy.data(), buffer, sizeof(buffer));
+    assert(copy[2] == Index(7));
+}
+
+template <typename Range>
+typename std::enable_if<
+    sizeof(jss::as_underlying_span(std::declval<Range>())) != 0,
+    small_result>::type
+test_as_underlying_span(int);
+template <typename Range> large_result test_as_underlying_span(...);
+
+template <typename StrongTypedef, typename Range>
+typename std::enable_if<
+    sizeof(jss::as_strong_span<StrongTypedef>(std::declval<Range>())) != 0,
+    small_result>::type
+test_as_strong_span(int);
+template <typename StrongTypedef, typename Range>
+large_result test_as_strong_span(...);
+
+void test_spans_of_temporary_containers_are_rejected() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Index= jss::strong_typedef<struct IndexTag, int>;
+
+    static_assert(
+        sizeof(test_as_underlying_span<std::vector<Index> &>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_as_underlying_span<std::vector<Index> const &>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_as_underlying_span<jss::span<Index>>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_as_underlying_span<std::vector<Index>>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_as_underlying_span<std::vector<Index> const>(0)) ==
+        sizeof(large_result));
+
+    static_assert(
+        sizeof(test_as_strong_span<Index, std::vector<int> &>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_as_strong_span<Index, jss::span<int const>>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_as_strong_span<Index, std::vector<int>>(0)) ==
+        sizeof(large_result));
+
+    std::vector<Index> indexes{Index(1), Index(2)};
+    jss::span<int> raw=
+        jss::as_underlying_span(jss::span<Index>(indexes.data(), 1));
+    assert(raw.size() == 1);
+    assert(raw[0] == 1);
+}
+
+template <typename T, typename U> constexpr bool same_triviality() {
+    return std::is_trivially_default_constructible<T>::value ==
+               std::is_trivially_default_constructible<U>::value &&
+           std::is_trivially_copy_constructible<T>::value ==
+               std::is_trivially_copy_constructible<U>::value &&
+           std::is_trivially_move_constructible<T>::value ==
+               std::is_trivially_move_constructible<U>::value &&
+           std::is_trivially_copy_assignable<T>::value ==
+               std::is_trivially_copy_assignable<U>::value &&
+           std::is_trivially_move_assignable<T>::value ==
+               std::is_trivially_move_assignable<U>::value &&
+           std::is_trivially_destructible<T>::value ==
+               std::is_trivially_destructible<U>::value &&
+           std::is_trivially_copyable<T>::value ==
+               std::is_trivially_copyable<U>::value &&
+           std::is_trivial<T>::value == std::is_trivial<U>::value;
+}
+
+void test_trivially_default_constructible_property() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Index= jss::strong_typedef<
+        struct IndexTag, int, jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable>;
+    using TrivialIndex= jss::strong_typedef<
+        struct IndexTag, int, jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable,
+        jss::strong_typedef_properties::trivially_default_constructible>;
+    using TrivialDouble= jss::strong_typedef<
+        struct DoubleTag, double,
+        jss::strong_typedef_properties::trivially_default_constructible>;
+    using TrivialName= jss::strong_typedef<
+        struct NameTag, std::string,
+        jss::strong_typedef_properties::trivially_default_constructible>;
+
+    static_assert(!std::is_trivially_default_constructible<Index>::value);
+    static_assert(std::is_trivially_copyable<Index>::value);
+    static_assert(std::is_trivially_destructible<Index>::value);
+
+    static_assert(same_triviality<TrivialIndex, int>());
+    static_assert(same_triviality<TrivialDouble, double>());
+    static_assert(same_triviality<TrivialName, std::string>());
+    static_assert(std::is_trivial<TrivialIndex>::value);
+    static_assert(jss::is_layout_transparent<TrivialIndex>::value);
+
+    TrivialIndex value_initialized{};
+    assert(value_initialized.underlying_value() == 0);
+    std::vector<TrivialIndex> indexes(10);
+    assert(indexes[9].underlying_value() == 0);
+    TrivialName name;
+    assert(name.underlying_value().empty());
+}
+
+template <typename Container, typename Index>
+typename std::enable_if<
+    sizeof(std::declval<Container &>()[std::declval<Index const &>()]) != 0,
+    small_result>::type
+test_subscript(int);
+template <typename Container, typename Index> large_result test_subscript(...);
+
+void test_index_vector() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using ChannelIndex= jss::strong_typedef<
+        struct ChannelIndexTag, unsigned,
+        jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable>;
+    using ItemIndex= jss::strong_typedef<
+        struct ItemIndexTag, unsigned,
+        jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable>;
+    using Channels= jss::index_vector<ChannelIndex, std::string>;
+
+    static_assert(
+        sizeof(test_subscript<Channels, ChannelIndex>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_subscript<Channels, ItemIndex>(0)) == sizeof(large_result));
+    static_assert(
+        sizeof(test_subscript<Channels, unsigned>(0)) == sizeof(large_result));
+
+    Channels channels{"zero", "one"};
+    assert(channels.size() == 2);
+    assert(channels[ChannelIndex(1)] == "one");
+    assert(channels.end_index() == ChannelIndex(2));
+
+    ChannelIndex const two= channels.push_back("two");
+    assert(two == ChannelIndex(2));
+    assert(channels[two] == "two");
+    ChannelIndex const three= channels.emplace_back(3, 'x');
+    assert(three == ChannelIndex(3));
+    assert(channels[three] == "xxx");
+    assert(channels.back() == "xxx");
+    assert(channels.contains(ChannelIndex(3)));
+    assert(!channels.contains(ChannelIndex(4)));
+
+    bool caught= false;
+    try {
+        channels.at(ChannelIndex(4));
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught);
+
+    std::string joined;
+    unsigned expected= 0;
+    for(ChannelIndex index : channels.indexes()) {
+        static_assert(std::is_same<decltype(index), ChannelIndex>::value);
+        assert(index.underlying_value() == expected++);
+        joined+= channels[index];
+    }
+    assert(expected == 4);
+    assert(joined == "zeroonetwoxxx");
+    assert(channels.indexes().size() == 4);
+
+    jss::index_range<ItemIndex> items(ItemIndex(3), ItemIndex(6));
+    unsigned total= 0;
+    for(auto item : items)
+        total+= item.underlying_value();
+    assert(total == 12);
+
+    std::vector<std::string> released= channels.release();
+    assert(released.size() == 4);
+    assert(channels.empty());
+}
+
+void test_soa_table() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using EntityId= jss::strong_typedef<
+        struct EntityIdTag, unsigned,
+        jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable>;
+    using OtherId= jss::strong_typedef<
+        struct OtherIdTag, unsigned,
+        jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::incrementable>;
+    using Position= jss::strong_typedef<
+        struct PositionTag, double, jss::strong_typedef_properties::addable>;
+    using Velocity= jss::strong_typedef<struct VelocityTag, double>;
+    using Entities= jss::soa_table<EntityId, Position, Velocity, std::string>;
+
+    static_assert(
+        sizeof(test_subscript<
+               jss::index_span<EntityId, Position>, EntityId>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_subscript<
+               jss::index_span<EntityId, Position>, OtherId>(0)) ==
+        sizeof(large_result));
+
+    Entities entities;
+    EntityId const first=
+        entities.push_back(Position(1.0), Velocity(0.5), "first");
+    EntityId const second=
+        entities.push_back(Position(10.0), Velocity(-1.0), "second");
+    assert(first == EntityId(0));
+    assert(second == EntityId(1));
+    assert(entities.size() == 2);
+    assert(entities.get<2>(second) == "second");
+    assert(entities.get<Velocity>(first).underlying_value() == 0.5);
+
+    auto positions= entities.column<Position>();
+    auto const velocities= entities.column<Velocity>();
+    assert(positions.data() + 1 == &entities.get<Position>(second));
+    for(EntityId id : entities.ids())
+        positions[id]+= velocities[id].underlying_value();
+    assert(entities.get<0>(first).underlying_value() == 1.5);
+    assert(entities.get<0>(second).underlying_value() == 9.0);
+
+    auto row= entities.row(first);
+    std::get<2>(row)= "renamed";
+    assert(entities.get<std::string>(first) == "renamed");
+
+    Entities const &const_entities= entities;
+    jss::index_span<EntityId, std::string const> names=
+        const_entities.column<2>();
+    assert(names[second] == "second");
+
+    entities.pop_back();
+    assert(entities.size() == 1);
+    assert(!entities.contains(second));
+    assert(entities.end_id() == second);
+}
+
+void test_id_map() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using EntityId= jss::strong_typedef<
+        struct EntityIdTag, std::uint32_t,
+        jss::strong_typedef_properties::equality_comparable>;
+    using OtherId= jss::strong_typedef<
+        struct OtherIdTag, std::uint32_t,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Names= jss::id_map<EntityId, std::string, 4>;
+
+    static_assert(
+        sizeof(test_subscript<Names, EntityId>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_subscript<Names, OtherId>(0)) == sizeof(large_result));
+    static_assert(
+        sizeof(test_subscript<Names, std::uint32_t>(0)) ==
+        sizeof(large_result));
+
+    Names names;
+    assert(names.empty());
+    assert(!names.contains(EntityId(3)));
+    assert(names.find(EntityId(1000)) == nullptr);
+
+    auto const inserted= names.try_emplace(EntityId(3), "three");
+    assert(inserted.second);
+    assert(*inserted.first == "three");
+    assert(!names.try_emplace(EntityId(3), "other").second);
+    names[EntityId(17)]= "seventeen";
+    names.insert_or_assign(EntityId(1000000), "million");
+    assert(!names.insert_or_assign(EntityId(3), "THREE").second);
+    assert(names.size() == 3);
+    assert(names.at(EntityId(3)) == "THREE");
+    assert(*names.find(EntityId(1000000)) == "million");
+    assert(!names.contains(EntityId(1000001)));
+
+    bool thrown= false;
+    try {
+        names.at(EntityId(4));
+    } catch(std::out_of_range const &) {
+        thrown= true;
+    }
+    assert(thrown);
+
+    std::vector<std::uint32_t> order;
+    for(auto [id, name] : names) {
+        order.push_back(id.underlying_value());
+        name+= "!";
+    }
+    assert((order == std::vector<std::uint32_t>{3, 17, 1000000}));
+    assert(names.values()[1] == "seventeen!");
+    assert(names.ids()[2] == EntityId(1000000));
+
+    assert(names.erase(EntityId(3)) == 1);
+    assert(names.erase(EntityId(3)) == 0);
+    assert(names.size() == 2);
+    assert(names.ids()[0] == EntityId(1000000));
+    assert(names.at(EntityId(1000000)) == "million!");
+    assert(names.at(EntityId(17)) == "seventeen!");
+
+    Names const copy(names);
+    names.clear();
+    assert(names.empty());
+    assert(!names.contains(EntityId(17)));
+    assert(copy.size() == 2);
+    assert(copy.at(EntityId(17)) == "seventeen!");
+    Names::const_iterator it= names.begin();
+    assert(it == names.end());
+
+    using WideId= jss::strong_typedef<
+        struct WideIdTag, std::uint64_t,
+        jss::strong_typedef_properties::equality_comparable>;
+    jss::id_map<WideId, int> wide;
+    std::uint64_t const huge= ~std::uint64_t(0) - 5;
+    wide[WideId(huge)]= 1;
+    wide[WideId(huge - 1)]= 2;
+    wide[WideId(1)]= 3;
+    wide[WideId(std::uint64_t(7) << 56 | 42)]= 4;
+    assert(wide.size() == 4);
+    assert(wide.at(WideId(huge)) == 1 && wide.at(WideId(huge - 1)) == 2);
+    assert(wide.at(WideId(std::uint64_t(7) << 56 | 42)) == 4);
+    assert(!wide.contains(WideId(huge - 2)));
+    jss::id_map<WideId, int> const wide_copy(wide);
+    assert(wide.erase(WideId(huge)) == 1);
+    assert(!wide.contains(WideId(huge)) && wide.at(WideId(huge - 1)) == 2);
+    assert(wide_copy.at(WideId(huge)) == 1);
+    wide.clear();
+    assert(!wide.contains(WideId(huge - 1)));
+
+    Names high;
+    high[EntityId(0xfffffff0u)]= "high";
+    assert(high.at(EntityId(0xfffffff0u)) == "high");
+
+    using SignedId= jss::strong_typedef<
+        struct SignedIdTag, int,
+        jss::strong_typedef_properties::equality_comparable>;
+    jss::id_map<SignedId, int> signed_map;
+    signed_map[SignedId(5)]= 5;
+    assert(!signed_map.contains(SignedId(-1)));
+    assert(signed_map.erase(SignedId(-1)) == 0);
+    thrown= false;
+    try {
+        signed_map[SignedId(-1)]= 1;
+    } catch(std::out_of_range const &) {
+        thrown= true;
+    }
+    assert(thrown && signed_map.size() == 1);
+}
+
+void test_id_allocator() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Handle= jss::strong_typedef<
+        struct HandleTag, std::uint32_t,
+        jss::strong_typedef_properties::comparable>;
+    using Allocator= jss::id_allocator<Handle, 8, 16>;
+
+    static_assert(Allocator::index_bits == 24);
+    static_assert(Allocator::index_limit == 0xffffff);
+
+    Allocator allocator(1);
+    Handle const first= allocator.allocate();
+    Handle const second= allocator.allocate();
+    assert(first == Handle(1));
+    assert(second == Handle(2));
+
+    allocator.release(first);
+    Handle const reused= allocator.allocate();
+    assert(reused != first);
+    assert(Allocator::index_of(reused) == Allocator::index_of(first));
+    assert(Allocator::generation_of(first) == 0);
+    assert(Allocator::generation_of(reused) == 1);
+    assert(allocator.allocate() == Handle(3));
+
+    constexpr unsigned thread_count= 4;
+    constexpr unsigned per_thread= 1000;
+    std::vector<std::vector<Handle>> live(thread_count);
+    std::vector<std::thread> threads;
+    for(unsigned t= 0; t < thread_count; ++t) {
+        threads.emplace_back([&allocator, &ids= live[t]] {
+            Allocator::cache cache(allocator);
+            for(unsigned i= 0; i < per_thread; ++i)
+                ids.push_back(cache.allocate());
+            for(unsigned i= 0; i < per_thread; i+= 2)
+                cache.release(ids[i]);
+            for(unsigned i= 0; i < per_thread; i+= 2)
+                ids[i]= cache.allocate();
+        });
+    }
+    for(auto &thread : threads)
+        thread.join();
+
+    std::vector<Handle> all{reused, second};
+    for(auto const &ids : live)
+        all.insert(all.end(), ids.begin(), ids.end());
+    std::sort(all.begin(), all.end());
+    assert(std::adjacent_find(all.begin(), all.end()) == all.end());
+
+    std::vector<std::uint32_t> indexes;
+    for(auto const &id : all)
+        indexes.push_back(Allocator::index_of(id));
+    std::sort(indexes.begin(), indexes.end());
+    assert(std::adjacent_find(indexes.begin(), indexes.end()) == indexes.end());
+
+    using SmallId= jss::strong_typedef<
+        struct SmallIdTag, std::uint8_t,
+        jss::strong_typedef_properties::equality_comparable>;
+    jss::id_allocator<SmallId, 4> small_allocator;
+    for(unsigned i= 0; i < 15; ++i)
+        small_allocator.allocate();
+    bool thrown= false;
+    try {
+        small_allocator.allocate();
+    } catch(std::length_error const &) {
+        thrown= true;
+    }
+    assert(thrown);
+
+    jss::id_allocator<SmallId, 4, 8> partial_allocator(10);
+    {
+        jss::id_allocator<SmallId, 4, 8>::cache cache(partial_allocator);
+        for(unsigned i= 10; i < 15; ++i)
+            assert(cache.allocate() == SmallId(static_cast<std::uint8_t>(i)));
+        thrown= false;
+        try {
+            cache.allocate();
+        } catch(std::length_error const &) {
+            thrown= true;
+        }
+        assert(thrown);
+    }
+
+    Allocator bulk_allocator;
+    constexpr unsigned bulk_count= 40000;
+    std::vector<Handle> bulk;
+    for(unsigned i= 0; i < bulk_count; ++i)
+        bulk.push_back(bulk_allocator.allocate());
+    for(auto const &id : bulk)
+        bulk_allocator.release(id);
+    std::vector<std::uint32_t> recycled;
+    for(unsigned i= 0; i < bulk_count; ++i) {
+        Handle const id= bulk_allocator.allocate();
+        assert(Allocator::generation_of(id) == 1);
+        recycled.push_back(Allocator::index_of(id));
+    }
+    std::sort(recycled.begin(), recycled.end());
+    assert(recycled.front() == 0 && recycled.back() == bulk_count - 1);
+    assert(
+        std::adjacent_find(recycled.begin(), recycled.end()) ==
+        recycled.end());
+
+    Allocator shared_allocator;
+    std::vector<std::vector<Handle>> held(thread_count);
+    threads.clear();
+    for(unsigned t= 0; t < thread_count; ++t) {
+        threads.emplace_back([&shared_allocator, &ids= held[t]] {
+            for(unsigned round= 0; round < 10; ++round) {
+                for(unsigned i= 0; i < 100; ++i)
+                    ids.push_back(shared_allocator.allocate());
+                for(unsigned i= 0; i < 50; ++i) {
+                    shared_allocator.release(ids.back());
+                    ids.pop_back();
+                }
+            }
+        });
+    }
+    for(auto &thread : threads)
+        thread.join();
+    std::vector<std::uint32_t> held_indexes;
+    for(auto const &ids : held)
+        for(auto const &id : ids)
+            held_indexes.push_back(Allocator::index_of(id));
+    std::sort(held_indexes.begin(), held_indexes.end());
+    assert(held_indexes.size() == thread_count * 500);
+    assert(
+        std::adjacent_find(held_indexes.begin(), held_indexes.end()) ==
+        held_indexes.end());
+}
+
+template <typename T>
+typename std::enable_if<
+    sizeof(std::declval<T &>().fetch_add(
+        std::declval<typename T::value_type const &>())) != 0,
+    small_result>::type
+test_fetch_add(int);
+template <typename T> large_result test_fetch_add(...);
+
+template <typename T>
+typename std::enable_if<
+    sizeof(std::declval<T &>().fetch_or(
+        std::declval<typename T::value_type const &>())) != 0,
+    small_result>::type
+test_fetch_or(int);
+template <typename T> large_result test_fetch_or(...);
+
+template <typename T>
+typename std::enable_if<sizeof(++std::declval<T &>()) != 0, small_result>::type
+test_atomic_increment(int);
+template <typename T> large_result test_atomic_increment(...);
+
+template <typename T, typename Other>
+typename std::enable_if<
+    sizeof(std::declval<T &>().fetch_add(std::declval<Other const &>())) != 0,
+    small_result>::type
+test_atomic_add_other(int);
+template <typename T, typename Other>
+large_result test_atomic_add_other(...);
+
+void test_atomic_strong() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Count= jss::strong_typedef<
+        struct CountTag, unsigned long,
+        jss::strong_typedef_properties::addable,
+        jss::strong_typedef_properties::incrementable,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Flags= jss::strong_typedef<
+        struct FlagsTag, unsigned,
+        jss::strong_typedef_properties::bitwise_or,
+        jss::strong_typedef_properties::bitwise_and,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Total= jss::strong_typedef<
+        struct TotalTag, double, jss::strong_typedef_properties::addable,
+        jss::strong_typedef_properties::subtractable>;
+    using OtherCount= jss::strong_typedef<
+        struct OtherCountTag, unsigned long,
+        jss::strong_typedef_properties::addable>;
+    using Plain= jss::strong_typedef<struct PlainTag, int>;
+
+    static_assert(
+        sizeof(test_fetch_add<jss::atomic_strong<Count>>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_fetch_or<jss::atomic_strong<Count>>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_atomic_increment<jss::atomic_strong<Count>>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_fetch_add<jss::atomic_strong<Flags>>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_fetch_or<jss::atomic_strong<Flags>>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_atomic_increment<jss::atomic_strong<Flags>>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_fetch_add<jss::atomic_strong<Plain>>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_atomic_add_other<jss::atomic_strong<Count>, OtherCount>(
+            0)) == sizeof(large_result));
+    static_assert(
+        jss::atomic_strong<Count>::is_always_lock_free ==
+        std::atomic<unsigned long>::is_always_lock_free);
+
+    jss::atomic_strong<Count> count;
+    assert(count.load() == Count(0));
+    assert(count.fetch_add(Count(5)) == Count(0));
+    assert((count+= Count(2)) == Count(7));
+    assert(++count == Count(8));
+    assert(count++ == Count(8));
+    assert(count.load(std::memory_order_relaxed) == Count(9));
+
+    Count expected(1);
+    assert(!count.compare_exchange_strong(expected, Count(2)));
+    assert(expected == Count(9));
+    assert(count.compare_exchange_strong(expected, Count(0)));
+
+    std::vector<std::thread> threads;
+    for(unsigned t= 0; t < 4; ++t) {
+        threads.emplace_back([&count] {
+            for(unsigned i= 0; i < 1000; ++i)
+                count.fetch_add(Count(1), std::memory_order_relaxed);
+        });
+    }
+    for(auto &thread : threads)
+        thread.join();
+    assert(count.load() == Count(4000));
+
+    jss::atomic_strong<Flags> flags(Flags(1));
+    assert(flags.fetch_or(Flags(6)) == Flags(1));
+    assert((flags&= Flags(5)) == Flags(5));
+    assert(flags.exchange(Flags(0)) == Flags(5));
+
+    jss::atomic_strong<Total> total(Total(1.5));
+    assert(total.fetch_add(Total(2.0)).underlying_value() == 1.5);
+    assert((total-= Total(0.5)).underlying_value() == 3.0);
+    assert(static_cast<Total>(total).underlying_value() == 3.0);
+}
+
+template <typename Counter, typename Amount>
+typename std::enable_if<
+    sizeof(std::declval<Counter &>().add(std::declval<Amount const &>()),
+           0) != 0,
+    small_result>::type
+test_counter_add(int);
+template <typename Counter, typename Amount>
+large_result test_counter_add(...);
+
+void test_sharded_counter() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Bytes= jss::strong_typedef<
+        struct BytesTag, std::uint64_t,
+        jss::strong_typedef_properties::addable,
+        jss::strong_typedef_properties::incrementable,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Packets= jss::strong_typedef<
+        struct PacketsTag, std::uint64_t,
+        jss::strong_typedef_properties::addable>;
+    using Seconds= jss::strong_typedef<
+        struct SecondsTag, double, jss::strong_typedef_properties::addable>;
+    using BytesCounter= jss::sharded_counter<Bytes, 8>;
+
+    static_assert(
+        sizeof(test_counter_add<BytesCounter, Bytes>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_counter_add<BytesCounter, Packets>(0)) ==
+        sizeof(large_result));
+    static_assert(
+        sizeof(test_counter_add<BytesCounter, std::uint64_t>(0)) ==
+        sizeof(large_result));
+    static_assert(sizeof(BytesCounter) >= 8 * JSS_CACHE_LINE_SIZE);
+
+    BytesCounter bytes;
+    assert(bytes.load() == Bytes(0));
+    bytes.add(Bytes(10));
+    bytes+= Bytes(5);
+    ++bytes;
+    assert(bytes.load() == Bytes(16));
+
+    std::vector<std::thread> threads;
+    for(unsigned t= 0; t < 4; ++t) {
+        threads.emplace_back([&bytes] {
+            for(unsigned i= 0; i < 10000; ++i)
+                ++bytes;
+        });
+    }
+    for(auto &thread : threads)
+        thread.join();
+    assert(bytes.load() == Bytes(40016));
+    assert(bytes.reset() == Bytes(40016));
+    assert(bytes.load() == Bytes(0));
+
+    jss::sharded_counter<Seconds> seconds;
+    seconds+= Seconds(0.5);
+    seconds+= Seconds(1.0);
+    assert(seconds.load().underlying_value() == 1.5);
+}
+
+template <typename T>
+typename std::enable_if<
+    sizeof(jss::serialize(
+        std::declval<T const &>(), std::declval<std::byte *>())) != 0,
+    small_result>::type
+test_serializable(int);
+template <typename T> large_result test_serializable(...);
+
+void test_serialization() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Id= jss::strong_typedef<
+        struct IdTag, std::uint32_t, jss::strong_typedef_properties::comparable,
+        jss::strong_typedef_properties::serializable>;
+    using Price= jss::strong_typedef<
+        struct PriceTag, double,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::serializable>;
+    using Plain= jss::strong_typedef<struct PlainTag, std::uint32_t>;
+
+    static_assert(sizeof(test_serializable<Id>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_serializable<Plain>(0)) == sizeof(large_result));
+    static_assert(jss::serialized_size_v<Id> == 4);
+
+    std::byte buffer[16];
+    assert(jss::serialize(Id(0x01020304), buffer) == buffer + 4);
+    assert(buffer[0] == std::byte{4} && buffer[3] == std::byte{1});
+    jss::serialize<jss::byte_order::big>(Id(0x01020304), buffer);
+    assert(buffer[0] == std::byte{1} && buffer[3] == std::byte{4});
+    Id id;
+    assert(
+        jss::deserialize<jss::byte_order::big>(
+            static_cast<std::byte const *>(buffer), id) == buffer + 4);
+    assert(id == Id(0x01020304));
+
+    Price price;
+    jss::serialize<jss::byte_order::big>(Price(1.25), buffer);
+    jss::deserialize<jss::byte_order::big>(
+        static_cast<std::byte const *>(buffer), price);
+    assert(price == Price(1.25));
+
+    std::vector<Id> ids;
+    for(std::uint32_t i= 0; i < 3000; ++i)
+        ids.push_back(Id(i * 7));
+    assert(jss::serialized_size(ids) == 12000);
+
+    std::vector<std::byte> bytes(jss::serialized_size(ids));
+    assert(jss::serialize(ids, bytes.data()) == bytes.data() + bytes.size());
+    std::vector<Id> native_ids(ids.size());
+    jss::deserialize(static_cast<std::byte const *>(bytes.data()), native_ids);
+    assert(native_ids == ids);
+
+    jss::serialize<jss::byte_order::big>(ids, bytes.data());
+    assert(bytes[4 * 1 + 3] == std::byte{7});
+    std::vector<Id> big_ids(ids.size());
+    jss::deserialize<jss::byte_order::big>(
+        static_cast<std::byte const *>(bytes.data()), big_ids);
+    assert(big_ids == ids);
+
+    std::stringstream stream;
+    jss::serialize<jss::byte_order::big>(stream, ids);
+    jss::serialize<jss::byte_order::native>(stream, ids);
+    jss::serialize(stream, Price(2.5));
+    assert(stream.str().size() == 2 * 12000 + 8);
+
+    std::vector<Id> from_stream(ids.size());
+    assert(jss::deserialize<jss::byte_order::big>(stream, from_stream));
+    assert(from_stream == ids);
+    std::fill(from_stream.begin(), from_stream.end(), Id(0));
+    assert(jss::deserialize<jss::byte_order::native>(stream, from_stream));
+    assert(from_stream == ids);
+    assert(jss::deserialize(stream, price));
+    assert(price == Price(2.5));
+    assert(!jss::deserialize(stream, price));
+    assert(price == Price(2.5));
+
+    using Level= jss::strong_typedef<
+        struct LevelTag, std::int32_t,
+        jss::strong_typedef_properties::bounded<5, 10>,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::serializable>;
+    static_assert(!noexcept(jss::deserialize(
+        std::declval<std::byte const *>(), std::declval<Level &>())));
+    static_assert(noexcept(jss::deserialize(
+        std::declval<std::byte const *>(), std::declval<Id &>())));
+
+    std::int32_t const raw_levels[]= {6, 100, 7};
+    std::byte level_bytes[sizeof(raw_levels)];
+    std::memcpy(level_bytes, raw_levels, sizeof(raw_levels));
+    std::byte const *const level_data= level_bytes;
+
+    Level level(5);
+    assert(
+        jss::deserialize<jss::byte_order::native>(level_data, level) ==
+        level_data + 4);
+    assert(level == Level(6));
+    bool caught= false;
+    try {
+        jss::deserialize<jss::byte_order::native>(level_data + 4, level);
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught);
+    assert(level == Level(6));
+
+    std::vector<Level> levels(3, Level(5));
+    caught= false;
+    try {
+        jss::deserialize<jss::byte_order::native>(level_data, levels);
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught);
+    assert(levels[0] == Level(6));
+    assert(levels[1] == Level(5));
+
+    std::stringstream level_stream;
+    level_stream.write(
+        reinterpret_cast<char const *>(level_bytes), sizeof(level_bytes));
+    assert(jss::deserialize<jss::byte_order::native>(level_stream, level));
+    assert(level == Level(6));
+    assert(!jss::deserialize<jss::byte_order::native>(level_stream, level));
+    assert(level == Level(6));
+
+    level_stream.clear();
+    level_stream.seekg(0);
+    assert(!jss::deserialize<jss::byte_order::native>(level_stream, levels));
+}
+
+template <typename T>
+typename std::enable_if<
+    std::is_convertible<
+        decltype(std::declval<std::istream &>() >> std::declval<T &>()),
+        std::istream &>::value,
+    small_result>::type
+test_input_streamable(int);
+template <typename T> large_result test_input_streamable(...);
+
+void test_parsable() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Id= jss::strong_typedef<
+        struct IdTag, int, jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::parsable>;
+    using Price= jss::strong_typedef<
+        struct PriceTag, double,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::parsable>;
+    using Name= jss::strong_typedef<
+        struct NameTag, std::string,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::parsable>;
+    using Plain= jss::strong_typedef<struct PlainTag, int>;
+
+    static_assert(
+        sizeof(test_input_streamable<Id>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_input_streamable<Plain>(0)) == sizeof(large_result));
+
+    std::istringstream is("42 3.5 fred x");
+    Id id;
+    Price price;
+    Name name;
+    is >> id >> price >> name;
+    assert(is);
+    assert(id == Id(42));
+    assert(price == Price(3.5));
+    assert(name == Name("fred"));
+    is >> id;
+    assert(!is);
+    assert(id == Id(42));
+
+    assert(jss::parse<Id>("-17") == Id(-17));
+    assert(!jss::parse<Id>("17x"));
+    assert(!jss::parse<Id>(""));
+    assert(!jss::parse<Id>("99999999999"));
+    assert(jss::parse<Price>("2.25") == Price(2.25));
+    assert(jss::parse<Name>("wilma") == Name("wilma"));
+
+    Id ids[4];
+    auto result= jss::parse_delimited("1,2,3\r\n4\n", ',', ids);
+    assert(result.ec == std::errc());
+    assert(result.count == 4);
+    assert(ids[2] == Id(3) && ids[3] == Id(4));
+
+    result= jss::parse_delimited("5,6,7,8,9", ',', ids);
+    assert(result.ec == std::errc::value_too_large);
+    assert(result.count == 4);
+    assert(std::string_view(result.ptr) == "9");
+
+    result= jss::parse_delimited("5,six,7", ',', ids);
+    assert(result.ec == std::errc::invalid_argument);
+    assert(result.count == 1);
+    assert(std::string_view(result.ptr, 3) == "six");
+
+    std::vector<Price> prices{Price(0.5)};
+    result= jss::parse_delimited("1.5\t2.5\t-3", '\t', prices);
+    assert(result.ec == std::errc());
+    assert(result.count == 3);
+    assert(
+        (prices ==
+         std::vector<Price>{Price(0.5), Price(1.5), Price(2.5), Price(-3)}));
+
+    std::vector<Name> names;
+    jss::parse_delimited("barney;betty", ';', names);
+    assert((names == std::vector<Name>{Name("barney"), Name("betty")}));
+
+    std::string_view const trailing("1,2,");
+    result= jss::parse_delimited(trailing, ',', ids);
+    assert(result.ec == std::errc::invalid_argument);
+    assert(result.count == 2);
+    assert(result.ptr == trailing.data() + trailing.size());
+    result= jss::parse_delimited("1\n2\n", '\n', ids);
+    assert(result.ec == std::errc());
+    assert(result.count == 2);
+    names.clear();
+    result= jss::parse_delimited("wilma;", ';', names);
+    assert(result.ec == std::errc::invalid_argument);
+    assert((names == std::vector<Name>{Name("wilma")}));
+}
+
+void test_parsing_checks_restricted_values() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Percent= jss::strong_typedef<
+        struct PercentTag, int, jss::strong_typedef_properties::bounded<0, 100>,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::parsable>;
+
+    assert(jss::parse<Percent>("100") == Percent(100));
+    assert(!jss::parse<Percent>("101"));
+    assert(!jss::parse<Percent>("-1"));
+
+    Percent values[3];
+    auto result= jss::parse_delimited("10,200,30", ',', values);
+    assert(result.ec == std::errc::result_out_of_range);
+    assert(result.count == 1);
+    assert(std::string_view(result.ptr, 3) == "200");
+    assert(values[0] == Percent(10));
+    assert(values[1] == Percent(0));
+
+    std::vector<Percent> column;
+    result= jss::parse_delimited("5\n150\n", ',', column);
+    assert(result.ec == std::errc::result_out_of_range);
+    assert(column == std::vector<Percent>{Percent(5)});
+
+    std::istringstream is("42 150");
+    Percent percent;
+    is >> percent;
+    assert(is && percent == Percent(42));
+    is >> percent;
+    assert(!is);
+    assert(percent == Percent(42));
+
+    std::istringstream ref_is("7");
+    ref_is >> std::ref(percent);
+    assert(ref_is && percent == Percent(7));
+
+    using Level= jss::strong_typedef<
+        struct LevelTag, int, jss::strong_typedef_properties::bounded<5, 10>,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::parsable>;
+
+    std::vector<Level> levels;
+    result= jss::parse_delimited("6,7,8", ',', levels);
+    assert(result.ec == std::errc());
+    assert(result.count == 3);
+    assert(levels == (std::vector<Level>{Level(6), Level(7), Level(8)}));
+    result= jss::parse_delimited("9,4", ',', levels);
+    assert(result.ec == std::errc::result_out_of_range);
+    assert(result.count == 1);
+    assert(levels.size() == 4);
+    assert(levels.back() == Level(9));
+}
+
+struct milliseconds_units : jss::format_units {
+    static constexpr std::string_view suffix= "ms";
+};
+
+struct dollar_units : jss::format_units {
+    static constexpr std::string_view prefix= "$";
+};
+
+template <typename T>
+typename std::enable_if<
+    sizeof(jss::to_chars(
+        std::declval<char *>(), std::declval<char *>(),
+        std::declval<T const &>())) != 0,
+    small_result>::type
+test_to_chars(int);
+template <typename T> large_result test_to_chars(...);
+
+void test_formattable() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Count= jss::strong_typedef<
+        struct CountTag, int, jss::strong_typedef_properties::formattable>;
+    using Milliseconds= jss::strong_typedef<
+        struct MillisecondsTag, long,
+        jss::strong_typedef_properties::formattable_with<milliseconds_units>>;
+    using Price= jss::strong_typedef<
+        struct PriceTag, double,
+        jss::strong_typedef_properties::formattable_with<dollar_units>>;
+    using Name= jss::strong_typedef<
+        struct NameTag, std::string,
+        jss::strong_typedef_properties::formattable>;
+    using Plain= jss::strong_typedef<struct PlainTag, int>;
+
+    static_assert(sizeof(test_to_chars<Count>(0)) == sizeof(small_result));
+    static_assert(sizeof(test_to_chars<Plain>(0)) == sizeof(large_result));
+    static_assert(sizeof(Milliseconds) == sizeof(long));
+
+    char buffer[32];
+    auto to_string= [&buffer](auto const &value) {
+        auto const result=
+            jss::to_chars(buffer, buffer + sizeof(buffer), value);
+        assert(result.ec == std::errc());
+        return std::string(buffer, result.ptr);
+    };
+    assert(to_string(Count(-42)) == "-42");
+    assert(to_string(Milliseconds(42)) == "42ms");
+    assert(to_string(Price(1.25)) == "$1.25");
+    assert(to_string(Name("fred")) == "fred");
+
+    auto const result= jss::to_chars(buffer, buffer + 3, Milliseconds(123));
+    assert(result.ec == std::errc::value_too_large);
+    assert(result.ptr == buffer + 3);
+    assert(
+        jss::to_chars(buffer, buffer + 3, Price(100)).ec ==
+        std::errc::value_too_large);
+    assert(jss::to_chars(buffer, buffer, Price(1)).ec != std::errc());
+
+#ifdef __cpp_lib_format
+    assert(std::format("{}", Milliseconds(42)) == "42ms");
+    assert(std::format("{:>6.2f}", Price(1.5)) == "$  1.50");
+#endif
+}
+
+void test_arithmetic_policies() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Checked= jss::strong_typedef<
+        struct CheckedTag, int,
+        jss::strong_typedef_properties::checked_arithmetic,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Saturating= jss::strong_typedef<
+        struct SaturatingTag, std::int8_t,
+        jss::strong_typedef_properties::saturating_arithmetic,
+        jss::strong_typedef_properties::equality_comparable>;
+    using SaturatingU= jss::strong_typedef<
+        struct SaturatingUTag, std::uint16_t,
+        jss::strong_typedef_properties::saturating_arithmetic,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Wrapping= jss::strong_typedef<
+        struct WrappingTag, std::int32_t,
+        jss::strong_typedef_properties::wrapping_arithmetic,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Other= jss::strong_typedef<
+        struct OtherTag, int,
+        jss::strong_typedef_properties::checked_arithmetic>;
+
+    static_assert(
+        std::is_same<decltype(Checked(1) + Checked(2)), Checked>::value);
+    static_assert(std::is_same<decltype(Checked(1) * 2), Checked>::value);
+    static_assert(std::is_same<decltype(2 - Checked(1)), Checked>::value);
+    static_assert(noexcept(Saturating(1) + Saturating(2)));
+    static_assert(!noexcept(Checked(1) + Checked(2)));
+    static_assert(!std::is_invocable<
+                  std::plus<>, Checked const &, Other const &>::value);
+
+    int const max= std::numeric_limits<int>::max();
+    int const min= std::numeric_limits<int>::min();
+    assert(Checked(40) + Checked(2) == Checked(42));
+    assert(Checked(40) - 2 == Checked(38));
+    assert(6 * Checked(7) == Checked(42));
+    bool caught= false;
+    try {
+        Checked c(max);
+        c+= 1;
+    } catch(std::overflow_error const &) {
+        caught= true;
+    }
+    assert(caught);
+    caught= false;
+    try {
+        (void)(Checked(min) - Checked(1));
+    } catch(std::overflow_error const &) {
+        caught= true;
+    }
+    assert(caught);
+    caught= false;
+    try {
+        (void)(Checked(max / 2 + 1) * 2);
+    } catch(std::overflow_error const &) {
+        caught= true;
+    }
+    assert(caught);
+    Checked unchanged(max);
+    try {
+        unchanged*= Checked(2);
+    } catch(std::overflow_error const &) {
+    }
+    assert(unchanged == Checked(max));
+
+    assert(Saturating(100) + Saturating(100) == Saturating(127));
+    assert(Saturating(-100) + Saturating(-100) == Saturating(-128));
+    assert(Saturating(-100) - Saturating(100) == Saturating(-128));
+    assert(Saturating(100) - Saturating(-100) == Saturating(127));
+    assert(Saturating(-16) * Saturating(16) == Saturating(-128));
+    assert(Saturating(-16) * Saturating(-16) == Saturating(127));
+    assert(Saturating(-64) * Saturating(2) == Saturating(-128));
+    assert(Saturating(50) + Saturating(-20) == Saturating(30));
+    Saturating s(120);
+    s+= 10;
+    assert(s == Saturating(127));
+    s-= Saturating(127);
+    assert(s == Saturating(0));
+
+    assert(SaturatingU(65000) + SaturatingU(1000) == SaturatingU(65535));
+    assert(SaturatingU(10) - SaturatingU(20) == SaturatingU(0));
+    assert(SaturatingU(300) * SaturatingU(300) == SaturatingU(65535));
+    assert(SaturatingU(255) * SaturatingU(257) == SaturatingU(65535));
+
+    assert(Wrapping(max) + Wrapping(1) == Wrapping(min));
+    assert(Wrapping(min) - 1 == Wrapping(max));
+    assert(Wrapping(0x10000) * Wrapping(0x10000) == Wrapping(0));
+    Wrapping w(min);
+    w*= -1;
+    assert(w == Wrapping(min));
+
+    std::vector<SaturatingU> lhs{
+        SaturatingU(1), SaturatingU(65535), SaturatingU(40000)};
+    std::vector<SaturatingU> rhs{
+        SaturatingU(2), SaturatingU(1), SaturatingU(40000)};
+    std::vector<SaturatingU> sums(lhs.size());
+    jss::bulk::add(lhs, rhs, sums);
+    assert(sums[0] == SaturatingU(3));
+    assert(sums[1] == SaturatingU(65535));
+    assert(sums[2] == SaturatingU(65535));
+}
+
+template <typename T> void check_bulk_saturating_kernels() {
+    using ST= jss::strong_typedef<
+        struct BulkSaturatingTag, T,
+        jss::strong_typedef_properties::saturating_arithmetic,
+        jss::strong_typedef_properties::equality_comparable>;
+    static_assert(jss::bulk::detail::has_policy_kernel<
+                  jss::bulk::detail::add_kernel, std::vector<ST> const,
+                  std::vector<ST> const, std::vector<ST>>::value);
+
+    T const values[]= {
+        std::numeric_limits<T>::min(),
+        static_cast<T>(std::numeric_limits<T>::min() + 1),
+        static_cast<T>(std::numeric_limits<T>::min() / 2),
+        static_cast<T>(-1),
+        0,
+        1,
+        static_cast<T>(std::numeric_limits<T>::max() / 2),
+        static_cast<T>(std::numeric_limits<T>::max() - 1),
+        std::numeric_limits<T>::max()};
+    std::vector<ST> lhs;
+    std::vector<ST> rhs;
+    for(T l : values) {
+        for(T r : values) {
+            lhs.push_back(ST(l));
+            rhs.push_back(ST(r));
+        }
+    }
+    std::vector<ST> sums(lhs.size());
+    std::vector<ST> differences(lhs.size());
+    jss::bulk::add(lhs, rhs, sums);
+    jss::bulk::subtract(lhs, rhs, differences);
+    for(std::size_t i= 0; i < lhs.size(); ++i) {
+        assert(sums[i] == lhs[i] + rhs[i]);
+        assert(differences[i] == lhs[i] - rhs[i]);
+    }
+
+    jss::bulk::add(lhs, rhs, lhs);
+    assert(lhs == sums);
+}
+
+void test_bulk_saturating_kernels() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    check_bulk_saturating_kernels<std::int8_t>();
+    check_bulk_saturating_kernels<std::uint8_t>();
+    check_bulk_saturating_kernels<std::int16_t>();
+    check_bulk_saturating_kernels<std::uint16_t>();
+    check_bulk_saturating_kernels<std::int32_t>();
+    check_bulk_saturating_kernels<std::uint32_t>();
+    check_bulk_saturating_kernels<std::int64_t>();
+    check_bulk_saturating_kernels<std::uint64_t>();
+
+    using Checked= jss::strong_typedef<
+        struct BulkCheckedTag, int,
+        jss::strong_typedef_properties::checked_arithmetic>;
+    static_assert(!jss::bulk::detail::has_policy_kernel<
+                  jss::bulk::detail::add_kernel, std::vector<Checked> const,
+                  std::vector<Checked> const, std::vector<Checked>>::value);
+}
+
+template <typename T>
+small_result
+test_bounded_value(decltype(std::declval<T const &>().bounded_value(), 0));
+template <typename T> large_result test_bounded_value(...);
+
+int digit_name_length(
+    jss::strong_typedef<
+        struct DigitTag, unsigned,
+        jss::strong_typedef_properties::bounded<0, 9>> digit) {
+    switch(digit.bounded_value()) {
+    case 0: return 4;
+    case 1:
+    case 2:
+    case 6: return 3;
+    case 3:
+    case 7:
+    case 8: return 5;
+    default: return 4;
+    }
+}
+
+void test_bounded() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Digit= jss::strong_typedef<
+        struct DigitTag, unsigned,
+        jss::strong_typedef_properties::bounded<0, 9>>;
+    using Offset= jss::strong_typedef<
+        struct OffsetTag, int,
+        jss::strong_typedef_properties::bounded<-3, 3>,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Plain= jss::strong_typedef<struct PlainTag, unsigned>;
+
+    static_assert(Digit::min_value == 0);
+    static_assert(Digit::max_value == 9);
+    static_assert(sizeof(Digit) == sizeof(unsigned));
+    static_assert(!noexcept(Digit(1)));
+    static_assert(noexcept(Plain(1)));
+    static_assert(
+        sizeof(test_bounded_value<Digit>(0)) == sizeof(small_result));
+    static_assert(
+        sizeof(test_bounded_value<Plain>(0)) == sizeof(large_result));
+
+    constexpr Digit seven(7);
+    static_assert(seven.bounded_value() == 7);
+
+    assert(Digit(0).bounded_value() == 0);
+    assert(Digit(9).bounded_value() == 9);
+    assert(Offset(-3) == Offset(-3));
+    assert(digit_name_length(Digit(3)) == 5);
+
+    for(unsigned value : {10u, 100u, ~0u}) {
+        bool caught= false;
+        try {
+            Digit d(value);
+            (void)d;
+        } catch(std::out_of_range const &) {
+            caught= true;
+        }
+        assert(caught);
+    }
+    for(int value : {-4, 4}) {
+        bool caught= false;
+        try {
+            Offset o(value);
+            (void)o;
+        } catch(std::out_of_range const &) {
+            caught= true;
+        }
+        assert(caught);
+    }
+
+    using Level= jss::strong_typedef<
+        struct LevelTag, int, jss::strong_typedef_properties::bounded<5, 10>>;
+    static_assert(!std::is_nothrow_default_constructible<Level>::value);
+    static_assert(std::is_nothrow_default_constructible<Plain>::value);
+    assert(Digit().bounded_value() == 0);
+    assert(std::vector<Digit>(3)[2].bounded_value() == 0);
+    for(int attempt= 0; attempt < 2; ++attempt) {
+        bool caught= false;
+        try {
+            if(attempt == 0) {
+                Level l;
+                (void)l;
+            } else {
+                std::vector<Level> levels(3);
+            }
+        } catch(std::out_of_range const &) {
+            caught= true;
+        }
+        assert(caught);
+    }
+
+    static_assert(jss::detail::bound_representable<std::uint8_t>(255));
+    static_assert(!jss::detail::bound_representable<std::uint8_t>(300));
+    static_assert(!jss::detail::bound_representable<std::uint8_t>(-1));
+    static_assert(!jss::detail::bound_representable<unsigned>(-1));
+    static_assert(jss::detail::bound_representable<std::int8_t>(-128));
+    static_assert(!jss::detail::bound_representable<std::int8_t>(-129));
+    static_assert(jss::detail::bound_representable<int>(~0u >> 1));
+    static_assert(!jss::detail::bound_representable<int>(~0u));
+    static_assert(jss::detail::bound_representable<float>(16777216));
+    static_assert(!jss::detail::bound_representable<float>(16777217));
+}
+
+void test_compact_storage() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Id= jss::strong_typedef<
+        struct IdTag, int,
+        jss::strong_typedef_properties::stored_as<std::uint16_t>,
+        jss::strong_typedef_properties::equality_comparable,
+        jss::strong_typedef_properties::addable>;
+    using Offset= jss::strong_typedef<
+        struct OffsetTag, long,
+        jss::strong_typedef_properties::stored_as<std::int8_t>,
+        jss::strong_typedef_properties::equality_comparable>;
+    using CompactId= jss::compact<Id>;
+
+    static_assert(sizeof(CompactId) == sizeof(std::uint16_t));
+    static_assert(std::is_trivially_copyable<CompactId>::value);
+    static_assert(std::is_trivially_default_constructible<CompactId>::value);
+    static_assert(std::is_same<CompactId::storage_type, std::uint16_t>::value);
+    static_assert(std::is_same<Id::underlying_value_type, int>::value);
+    static_assert(
+        std::is_same<decltype(std::declval<Id &>().underlying_value()),
+                     int &>::value);
+    static_assert(CompactId(Id(7)).value() == Id(7));
+
+    CompactId c(Id(65535));
+    assert(c.stored_value() == 65535);
+    Id const widened= c;
+    assert(widened == Id(65535));
+    assert(c.value() + Id(1) == Id(65536));
+    assert(CompactId::from_stored_value(42).value() == Id(42));
+    assert(jss::compact<Offset>(Offset(-128)).value() == Offset(-128));
+
+    for(int value : {-1, 65536}) {
+        bool caught= false;
+        try {
+            CompactId bad{Id(value)};
+            (void)bad;
+        } catch(std::out_of_range const &) {
+            caught= true;
+        }
+        assert(caught);
+    }
+
+    std::vector<Id> ids{Id(1), Id(300), Id(65535)};
+    std::vector<CompactId> stored(ids.size());
+    jss::narrow_copy(ids, stored);
+    assert(stored[1].stored_value() == 300);
+    std::vector<Id> restored(stored.size());
+    jss::widen_copy(stored, restored);
+    assert(restored == ids);
+
+    ids.push_back(Id(70000));
+    std::vector<CompactId> unchanged(ids.size(), CompactId(Id(5)));
+    bool caught= false;
+    try {
+        jss::narrow_copy(ids, unchanged);
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught);
+    for(auto const &value : unchanged)
+        assert(value.value() == Id(5));
+}
+
+void test_packed_array() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Category= jss::strong_typedef<
+        struct CategoryTag, unsigned,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Delta= jss::strong_typedef<
+        struct DeltaTag, int,
+        jss::strong_typedef_properties::equality_comparable>;
+
+    jss::packed_array<Category, 3> categories;
+    static_assert(decltype(categories)::bits == 3);
+    static_assert(std::is_same<
+                  decltype(std::as_const(categories)[0]), Category>::value);
+    assert(categories.empty());
+
+    for(unsigned i= 0; i < 1000; ++i)
+        categories.push_back(Category(i % 8));
+    assert(categories.size() == 1000);
+    assert(categories.capacity() >= 1000);
+    for(unsigned i= 0; i < 1000; ++i)
+        assert(std::as_const(categories)[i] == Category(i % 8));
+
+    categories[21]= Category(5);
+    assert(categories.get(21) == Category(5));
+    assert(categories.get(20) == Category(4));
+    assert(categories.get(22) == Category(6));
+    Category const read= categories[21];
+    assert(read == Category(5));
+    categories[0]= categories[21];
+    assert(categories.front() == Category(5));
+
+    bool caught= false;
+    try {
+        categories[1]= Category(8);
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught);
+    assert(categories.get(1) == Category(1));
+    caught= false;
+    try {
+        categories.at(1000);
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught);
+
+    std::vector<Category> iterated(categories.begin(), categories.end());
+    assert(iterated.size() == categories.size());
+    std::vector<Category> unpacked;
+    categories.unpack(unpacked);
+    assert(unpacked == iterated);
+    for(std::size_t first : {0u, 5u, 64u, 100u}) {
+        std::vector<Category> part(900 - first);
+        categories.unpack(first, part);
+        for(std::size_t i= 0; i < part.size(); ++i)
+            assert(part[i] == iterated[first + i]);
+    }
+
+    categories.resize(10);
+    categories.resize(20);
+    assert(categories.get(9) == Category(1));
+    assert(categories.get(10) == Category(0));
+    assert(categories.get(19) == Category(0));
+    categories.pop_back();
+    assert(categories.size() == 19);
+    categories.clear();
+    assert(categories.empty() && categories.begin() == categories.end());
+
+    jss::packed_array<Delta, 12> deltas{Delta(-2048), Delta(2047), Delta(-1)};
+    assert(deltas.get(0) == Delta(-2048));
+    assert(deltas.get(1) == Delta(2047));
+    assert(deltas.back() == Delta(-1));
+    caught= false;
+    try {
+        deltas.push_back(Delta(2048));
+    } catch(std::out_of_range const &) {
+        caught= true;
+    }
+    assert(caught && deltas.size() == 3);
+
+    jss::packed_array<Delta, 32> wide(70, Delta(-5));
+    std::vector<Delta> wide_values;
+    wide.unpack(wide_values);
+    assert(wide_values == std::vector<Delta>(70, Delta(-5)));
+
+    jss::packed_array<Delta, 12> moved(std::move(deltas));
+    assert(moved.size() == 3 && moved.get(1) == Delta(2047));
+    assert(deltas.empty() && deltas.size() == 0);
+    assert(deltas.begin() == deltas.end());
+    assert(deltas.capacity() < 64);
+    deltas.push_back(Delta(7));
+    assert(deltas.size() == 1 && deltas.get(0) == Delta(7));
+    deltas.clear();
+    deltas= std::move(moved);
+    assert(deltas.size() == 3 && deltas.get(0) == Delta(-2048));
+    assert(moved.empty() && moved.begin() == moved.end());
+    moved.push_back(Delta(-7));
+    assert(moved.get(0) == Delta(-7));
+}
+
+template <typename Lhs, typename Rhs>
+small_result
+test_flags_or(decltype(std::declval<Lhs>() | std::declval<Rhs>()) *);
+template <typename Lhs, typename Rhs> large_result test_flags_or(...);
+
+void test_flags() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    enum class permission { read, write, execute };
+    using Permission= jss::strong_typedef<struct PermissionTag, permission>;
+    using Feature= jss::strong_typedef<struct FeatureTag, unsigned>;
+    using Permissions= jss::flags<Permission>;
+    using Features= jss::flags<Feature, 256>;
+
+    static_assert(sizeof(Permissions) == sizeof(std::uint64_t));
+    static_assert(sizeof(Features) == 32);
+    static_assert(Features::size() == 256);
+    static_assert(
+        sizeof(test_flags_or<Permissions, Permissions>(0)) ==
+        sizeof(small_result));
+    static_assert(
+        sizeof(test_flags_or<Permissions, jss::flags<Feature>>(0)) ==
+        sizeof(large_result));
+
+    constexpr Permissions read_write{
+        Permission(permission::read), Permission(permission::write)};
+    static_assert(read_write.count() == 2);
+    static_assert(read_write.test(Permission(permission::write)));
+    static_assert(!read_write.test(Permission(permission::execute)));
+
+    Permissions p;
+    assert(p.none() && !p.any() && p.count() == 0);
+    p.set(Permission(permission::execute));
+    assert(p.test(Permission(permission::execute)) && p.count() == 1);
+    p.flip(Permission(permission::read));
+    assert(p.test(Permission(permission::read)));
+    p.reset(Permission(permission::execute));
+    assert(p == Permissions{Permission(permission::read)});
+    assert(read_write.contains_all(p));
+    assert(!p.contains_all(read_write));
+    assert(p.contains_any(read_write));
+    assert((p | read_write) == read_write);
+    assert((p & read_write) == p);
+    assert((p ^ read_write) == Permissions{Permission(permission::write)});
+    assert(
+        and_not(read_write, p) == Permissions{Permission(permission::write)});
+    assert((~Permissions()).count() == 64);
+    p.set(read_write);
+    assert(p == read_write);
+    p.reset(read_write);
+    assert(p.none());
+
+    Features f{
+        Feature(0), Feature(63), Feature(64), Feature(200), Feature(255)};
+    assert(f.count() == 5);
+    assert(f.test(Feature(64)) && !f.test(Feature(65)));
+    assert(f.word(0) == (std::uint64_t(1) | (std::uint64_t(1) << 63)));
+    assert(
+        f.word(3) == ((std::uint64_t(1) << 8) | (std::uint64_t(1) << 63)));
+    assert((~f).count() == 251);
+    assert((~f & f).none());
+    assert((~f | f).count() == 256);
+    Features g{Feature(64), Feature(100)};
+    assert((f & g) == Features{Feature(64)});
+    assert(and_not(f, g).count() == 4);
+    assert(f != g);
+    std::vector<unsigned> seen;
+    f.for_each(
+        [&](Feature feature) { seen.push_back(feature.underlying_value()); });
+    assert((seen == std::vector<unsigned>{0, 63, 64, 200, 255}));
+    f.clear();
+    assert(f.none());
+
+    jss::flags<Feature, 70> odd;
+    assert((~odd).count() == 70);
+}
+
+template <typename StrongTypedef>
+bool mapped_column_throws(
+    std::string const &path, std::string_view name) {
+    try {
+        jss::mapped_column<StrongTypedef> column(path, name);
+    } catch(std::runtime_error const &) {
+        return true;
+    }
+    return false;
+}
+
+void test_mapped_column() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using OrderId= jss::strong_typedef<
+        struct OrderIdTag, std::uint64_t,
+        jss::strong_typedef_properties::serializable,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Signed= jss::strong_typedef<
+        struct SignedTag, std::int64_t,
+        jss::strong_typedef_properties::serializable>;
+    using Small= jss::strong_typedef<
+        struct SmallTag, std::uint32_t,
+        jss::strong_typedef_properties::serializable>;
+
+    std::string const path= "test_mapped_column.tmp";
+    std::vector<OrderId> ids;
+    for(std::uint64_t i= 0; i < 10000; ++i)
+        ids.push_back(OrderId(i * 7919));
+    jss::write_mapped_column(path, "order_id", ids);
+
+    {
+        jss::mapped_column<OrderId> column(path, "order_id");
+        assert(column.size() == ids.size());
+        assert(!column.empty());
+        assert(column[1] == OrderId(7919));
+        assert(std::equal(column.begin(), column.end(), ids.begin()));
+        auto const values= column.values();
+        assert(values.size() == ids.size());
+        assert(reinterpret_cast<std::uintptr_t>(values.data()) %
+                   alignof(OrderId) ==
+               0);
+
+        jss::mapped_column<OrderId> moved(std::move(column));
+        assert(column.empty() && moved.size() == ids.size());
+        column= std::move(moved);
+        assert(column[9999] == ids[9999]);
+    }
+    {
+        jss::mapped_column<OrderId> column(
+            path, "order_id", jss::mapped_column_mode::copy_on_write);
+        column.mutable_values()[0]= OrderId(42);
+        assert(column[0] == OrderId(42));
+    }
+    {
+        jss::mapped_column<OrderId> column(path, "order_id");
+        assert(column[0] == OrderId(0));
+    }
+
+    assert(mapped_column_throws<OrderId>(path, "customer_id"));
+    assert(mapped_column_throws<Signed>(path, "order_id"));
+    assert(mapped_column_throws<Small>(path, "order_id"));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream is(path, std::ios::binary);
+        bytes.assign(
+            std::istreambuf_iterator<char>(is),
+            std::istreambuf_iterator<char>());
+    }
+    assert(bytes.size() == 64 + ids.size() * sizeof(OrderId));
+    assert(
+        std::memcmp(
+            bytes.data() + 64, ids.data(), ids.size() * sizeof(OrderId)) == 0);
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        os.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+    }
+    assert(mapped_column_throws<OrderId>(path, "order_id"));
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        os << "not a column";
+    }
+    assert(mapped_column_throws<OrderId>(path, "order_id"));
+
+    jss::write_mapped_column(path, "empty", std::vector<OrderId>());
+    assert(jss::mapped_column<OrderId>(path, "empty").empty());
+    std::remove(path.c_str());
+
+    bool caught= false;
+    try {
+        jss::mapped_column<OrderId> column(path, "order_id");
+    } catch(std::system_error const &) {
+        caught= true;
+    }
+    assert(caught);
+}
+
+void test_heterogeneous_lookup() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Name= jss::strong_typedef<
+        struct NameTag, std::string,
+        jss::strong_typedef_properties::hashable,
+        jss::strong_typedef_properties::comparable>;
+    using Fibonacci= jss::strong_typedef<
+        struct FibonacciTag, std::string,
+        jss::strong_typedef_properties::hashable_with<
+            jss::hash_policies::fibonacci>>;
+    using NameView= jss::strong_view<Name>;
+
+    static_assert(
+        std::is_same<NameView::underlying_value_type, std::string_view>::value,
+        "A view of a string holds a string_view");
+    static_assert(
+        std::is_convertible<Name const &, NameView>::value,
+        "A view can be implicitly created from the strong_typedef");
+    static_assert(
+        !std::is_convertible<std::string_view, NameView>::value,
+        "A view cannot be implicitly created from a string_view");
+    static_assert(
+        !std::is_convertible<Fibonacci const &, NameView>::value,
+        "A view cannot be created from another strong_typedef");
+    static_assert(
+        std::is_invocable<jss::transparent_less<Name>, Name, NameView>::value,
+        "Names and views can be compared");
+    static_assert(
+        !std::is_invocable<
+            jss::transparent_less<Name>, Name, std::string_view>::value,
+        "Names cannot be compared with raw string_views");
+
+    Name const alice("alice");
+    NameView const view(alice);
+    assert(view.underlying_value().data() == alice.underlying_value().data());
+    assert(
+        jss::transparent_hash<Name>()(alice) ==
+        jss::transparent_hash<Name>()(NameView("alice")));
+    assert(
+        jss::transparent_hash<Name>()(alice) == std::hash<Name>()(alice));
+    Fibonacci const fib("fib");
+    assert(
+        jss::transparent_hash<Fibonacci>()(
+            jss::strong_view<Fibonacci>(fib)) == std::hash<Fibonacci>()(fib));
+
+    jss::transparent_equal_to<Name> const equal;
+    assert(equal(alice, NameView("alice")));
+    assert(equal(NameView("alice"), alice));
+    assert(!equal(view, NameView("bob")));
+
+    std::map<Name, int, jss::transparent_less<Name>> ages;
+    ages[Name("alice")]= 30;
+    ages[Name("bob")]= 25;
+    std::string_view const key= "bob";
+    auto const found= ages.find(NameView(key));
+    assert(found != ages.end() && found->second == 25);
+    assert(ages.find(NameView("carol")) == ages.end());
+    assert(ages.count(NameView("alice")) == 1);
+
+    std::set<Name, jss::transparent_less<Name>> names{alice, Name("bob")};
+    assert(names.find(NameView("alice")) != names.end());
+
+    std::unordered_map<
+        Name, int, jss::transparent_hash<Name>, jss::transparent_equal_to<Name>>
+        ids;
+    ids[alice]= 1;
+#ifdef __cpp_lib_generic_unordered_lookup
+    assert(ids.find(NameView("alice")) != ids.end());
+    assert(ids.find(NameView("bob")) == ids.end());
+#else
+    assert(ids.find(alice) != ids.end());
+#endif
+}
+
+using ViewName= jss::strong_typedef<
+    struct ViewNameTag, std::string,
+    jss::strong_typedef_properties::comparable,
+    jss::strong_typedef_properties::hashable,
+    jss::strong_typedef_properties::streamable>;
+
+std::size_t view_length(jss::view_of<ViewName> name) {
+    return name.underlying_value().size();
+}
+
+/// A property that rejects empty strings, for checking that views are
+/// validated
+struct non_empty {
+    template <typename Derived, typename ValueType> struct mixin {};
+
+    static void validate_value(std::string_view value) {
+        if(value.empty())
+            throw std::invalid_argument("empty");
+    }
+};
+
+void test_view_of() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Name= ViewName;
+    using NameView= jss::view_of<Name>;
+    using Other= jss::strong_typedef<
+        struct OtherNameTag, std::string,
+        jss::strong_typedef_properties::comparable>;
+    using Samples= jss::strong_typedef<struct SamplesTag, std::vector<int>>;
+
+    static_assert(
+        std::is_same<
+            NameView,
+            jss::strong_typedef<
+                ViewNameTag, std::string_view,
+                jss::strong_typedef_properties::comparable,
+                jss::strong_typedef_properties::hashable,
+                jss::strong_typedef_properties::streamable>>::value,
+        "A view has the same tag and properties");
+    static_assert(
+        std::is_same<jss::strong_view<Name>, NameView>::value,
+        "strong_view is the same as view_of");
+    static_assert(
+        std::is_convertible<Name const &, NameView>::value,
+        "A view can be implicitly created from the strong_typedef");
+    static_assert(
+        std::is_nothrow_constructible<NameView, Name const &>::value,
+        "Creating a view cannot throw");
+    static_assert(
+        !std::is_convertible<NameView, Name>::value,
+        "A strong_typedef cannot be implicitly created from a view");
+    static_assert(
+        !std::is_convertible<std::string_view, NameView>::value,
+        "A view cannot be implicitly created from a string_view");
+    static_assert(
+        !std::is_constructible<NameView, Other const &>::value,
+        "A view cannot be created from a different strong_typedef");
+    static_assert(
+        !std::is_constructible<jss::view_of<Other>, Name const &>::value,
+        "A view cannot be created from a different strong_typedef");
+    static_assert(
+        std::is_same<
+            jss::view_of<Samples>::underlying_value_type,
+            jss::span<int const>>::value,
+        "A view of a vector holds a span");
+
+    Name const alice("alice");
+    assert(view_length(alice) == 5);
+    char const buffer[]= "bob and carol";
+    assert(view_length(NameView(std::string_view(buffer, 3))) == 3);
+
+    NameView const view= alice;
+    assert(view.underlying_value().data() == alice.underlying_value().data());
+    assert(view == NameView("alice"));
+    assert(view != NameView("bob"));
+    assert(view < NameView("bob"));
+    assert(std::hash<NameView>()(view) == std::hash<Name>()(alice));
+
+    Name const bob("bob");
+    std::string_view const text("alice");
+    assert(NameView(text) == alice);
+    assert(alice == NameView(text));
+    assert(NameView(text) != bob);
+    assert(bob != NameView(text));
+    assert(alice < NameView("bob"));
+    assert(NameView(text) < bob);
+    assert(bob > NameView(text));
+    assert(NameView("bob") > alice);
+    assert(alice <= NameView(text));
+    assert(NameView(text) >= alice);
+    assert(!(bob <= NameView(text)));
+
+    std::ostringstream os;
+    os << view;
+    assert(os.str() == "alice");
+
+    Samples const samples(std::vector<int>{1, 2, 3});
+    jss::view_of<Samples> const samples_view= samples;
+    assert(samples_view.underlying_value().size() == 3);
+    assert(
+        samples_view.underlying_value().data() ==
+        samples.underlying_value().data());
+
+    using Label= jss::strong_typedef<struct LabelTag, std::string, non_empty>;
+    using LabelView= jss::view_of<Label>;
+    static_assert(
+        !std::is_nothrow_constructible<LabelView, Label const &>::value,
+        "Creating a view of a restricted value is checked");
+    Label label("x");
+    assert(LabelView(label).underlying_value() == "x");
+    label.underlying_value().clear();
+    bool caught= false;
+    try {
+        LabelView const empty_view= label;
+        (void)empty_view;
+    } catch(std::invalid_argument const &) {
+        caught= true;
+    }
+    assert(caught);
+}
+
+void test_interned_string() {
+    std::cout << __FUNCTION__ << std::endl;
+
+    using Symbol= jss::interned_string<struct SymbolTag>;
+    using Host= jss::interned_string<struct HostTag>;
+
+    static_assert(
+        sizeof(Symbol) == sizeof(std::uint32_t),
+        "An interned string is a 32-bit handle");
+    static_assert(
+        std::is_trivially_copyable<Symbol>::value,
+        "Interned strings are cheap to copy");
+    static_assert(
+        !std::is_convertible<std::string_view, Symbol>::value,
+        "Interning must be explicit");
+    static_assert(
+        !std::is_constructible<Symbol, Host>::value,
+        "Interned strings with different tags are different types");
+
+    Symbol const empty;
+    assert(empty.empty() && empty.view().empty());
+    assert(Symbol("") == empty);
+
+    Symbol const ibm("IBM");
+    std::string const text= "IBM";
+    Symbol const ibm2(text);
+    assert(ibm == ibm2 && ibm.handle() == ibm2.handle());
+    assert(ibm.view().data() == ibm2.view().data());
+    assert(ibm.view() == "IBM" && ibm.str() == "IBM");
+    Symbol const aapl("AAPL");
+    assert(ibm != aapl);
+    assert(aapl < ibm && ibm > aapl && aapl <= ibm && ibm >= ibm2);
+    assert(!(ibm < ibm2));
+    assert(std::hash<Symbol>()(ibm) == std::hash<Symbol>()(ibm2));
+    assert(Host("IBM").view() == "IBM");
+
+    std::ostringstream os;
+    os << ibm;
+    assert(os.str() == "IBM");
+
+    std::unordered_set<Symbol> symbols{ibm, ibm2, aapl};
+    assert(symbols.size() == 2);
+
+    unsigned const thread_count= 4;
+    unsigned const string_count= 3000;
+    std::vector<std::vector<Symbol>> results(thread_count);
+    std::vector<std::thread> threads;
+    for(unsigned t= 0; t < thread_count; ++t) {
+        threads.emplace_back([&results, t] {
+            for(unsigned i= 0; i < string_count; ++i)
+                results[t].push_back(Symbol(
+                    "sym" + std::to_string((i * (t + 1)) % string_count)));
+        });
+    }
+    for(auto &thread : threads)
+        thread.join();
+    for(unsigned t= 0; t < thread_count; ++t) {
+        for(unsigned i= 0; i < string_count; ++i) {
+            Symbol const &value= results[t][i];
+            assert(
+                value.view() ==
+                "sym" + std::to_string((i * (t + 1)) % string_count));
+            assert(value == results[0][(i * (t + 1)) % string_count]);
+        }
+    }
+    assert(jss::intern_table<SymbolTag>::instance().size() == string_count + 3);
+}
+
+void test_three_way_comparable() {
+    std::cout << __FUNCTION__ << std::endl;
+
+#if defined(__cpp_impl_three_way_comparison) &&                                \
+    defined(__cpp_lib_three_way_comparison)
+    using Key= jss::strong_typedef<
+        struct KeyTag, std::string,
+        jss::strong_typedef_properties::three_way_comparable,
+        jss::strong_typedef_properties::equality_comparable>;
+    using Price= jss::strong_typedef<
+        struct PriceTag, double,
+        jss::strong_typedef_properties::three_way_comparable>;
+    using Count= jss::strong_typedef<
+        struct CountTag, int,
+        jss::strong_typedef_properties::three_way_comparable>;
+    using Plain= jss::strong_typedef<struct PlainTag, int>;
+
+    static_assert(
+        std::is_same<
+            decltype(std::declval<Key const &>() <=>
+                     std::declval<Key const &>()),
+            std::strong_ordering>::value,
+        "The comparison category is that of the underlying type");
+    static_assert(
+        std::is_same<
+            decltype(std::declval<Price const &>() <=>
+                     std::declval<Price const &>()),
+            std::partial_ordering>::value,
+        "The comparison category is that of the underlying type");
+    static_assert(
+        noexcept(std::declval<Count const &>() < std::declval<Count const &>()),
+        "Comparing ints cannot throw");
+    static_assert(
+        !std::three_way_comparable<Plain>,
+        "Three-way comparison must be enabled by the property");
+    static_assert(
+        !std::three_way_comparable_with<Count, int>,
+        "Three-way comparison is only with the same strong_typedef");
+
+    static_assert((Count(1) <=> Count(2)) < 0);
+    static_assert(Count(1) < Count(2) && Count(3) >= Count(3));
+    static_assert(Count(2) > Count(1) && !(Count(2) <= Count(1)));
+
+    Key const apple("apple");
+    Key const banana("banana");
+    assert((apple <=> banana) < 0);
+    assert((banana <=> apple) > 0);
+    assert((apple <=> Key("apple")) == 0);
+    assert(apple < banana && apple <= banana && banana > apple);
+    assert(banana >= apple && apple == Key("apple"));
+
+    Price const nan(std::numeric_limits<double>::quiet_NaN());
+    assert(!(nan < Price(1.0)) && !(nan >= Price(1.0)));
+
+    std::map<Key, int> counts;
+    counts[banana]= 2;
+    counts[apple]= 1;
+    assert(counts.begin()->first == apple);
+    std::vector<Key> keys{banana, Key("cherry"), apple};
+    std::sort(keys.begin(), keys.end());
+    assert(keys.front() == apple && keys.back() == Key("cherry"));
+#endif
+}
+
 int main() {
     test_strong_typedef_is_not_original();
     test_strong_typedef_explicitly_convertible_from_source();
@@ -1840,6 +4080,8 @@ int main() {
     test_strong_typedef_is_copyable_and_movable();
     test_by_default_strong_typedef_is_not_equality_comparable();
     test_can_get_underlying_value_and_type();
+    test_free_underlying_value_function();
+    test_operators_accept_implicitly_convertible_operands();
     test_strong_typedef_is_equality_comparable_if_tagged_as_such();
     test_by_default_strong_typedef_is_not_incrementable();
     test_strong_typedef_is_incrementable_if_tagged_as_such();
@@ -1854,6 +4096,7 @@ int main() {
     test_strong_typedef_is_mixed_ordered_if_tagged_as_such();
     test_by_default_strong_typedef_is_not_hashable();
     test_strong_typedef_is_hashable_if_tagged_as_such();
+    test_hashable_with_hash_policy();
     test_by_default_strong_typedef_is_not_streamable();
     test_strong_typedef_is_streamable_if_tagged_as_such();
     test_properties_can_be_combined();
@@ -1877,4 +4120,29 @@ int main() {
     test_bitwise_right_shift();
     test_compound_assignment();
     test_adding_two_strong_typedefs();
+    test_bulk_operations_follow_properties();
+    test_layout_transparency();
+    test_spans_of_temporary_containers_are_rejected();
+    test_trivially_default_constructible_property();
+    test_index_vector();
+    test_soa_table();
+    test_id_map();
+    test_id_allocator();
+    test_atomic_strong();
+    test_sharded_counter();
+    test_serialization();
+    test_parsable();
+    test_parsing_checks_restricted_values();
+    test_formattable();
+    test_arithmetic_policies();
+    test_bulk_saturating_kernels();
+    test_bounded();
+    test_compact_storage();
+    test_packed_array();
+    test_flags();
+    test_mapped_column();
+    test_heterogeneous_lookup();
+    test_view_of();
+    test_interned_string();
+    test_three_way_comparable();
 }